@@ -0,0 +1,147 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+/*
+ * Compares the virtual TwoPointCrossover, which appends its children
+ * to a vector of chromosomes, with the crossover operators crossing
+ * a whole batch of parents into fixed buffers through breed_pairs.
+ *
+ * Usage: bench_crossover [batch size]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "crossover.h"
+
+
+using namespace std;
+using namespace xcsf;
+
+
+static const double MINIMUM_DURATION = 0.2; // seconds
+
+static volatile unsigned int sink = 0;
+
+
+double
+nanoseconds_per_pair(unsigned int pair_count, const std::function<void (void)>& breed)
+{
+  typedef chrono::steady_clock Clock;
+
+  unsigned long count = 0;
+  const Clock::time_point start = Clock::now();
+  double elapsed = 0;
+  do {
+    breed();
+    count += pair_count;
+    elapsed = chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < MINIMUM_DURATION);
+
+  return 1e9 * elapsed / count;
+}
+
+
+template <class Operator>
+double
+time_operator(const Operator& cross, const Chromosome& parents, Chromosome& children,
+	      unsigned int pair_count, unsigned int length)
+{
+  return nanoseconds_per_pair(pair_count, [&] () {
+      breed_pairs(cross, parents.data(), children.data(), pair_count, length);
+      sink += children[0];
+    });
+}
+
+
+void
+benchmark(unsigned int input_count, unsigned int pair_count, const Randomizer& generate)
+{
+  const unsigned int length = 2 * input_count + 1;
+
+  Chromosome parents(2 * pair_count * length);
+  for (auto& each_allele: parents) {
+    each_allele = generate.unsigned_int(0, Value::MAXIMUM + 1);
+  }
+  Chromosome children(parents.size());
+
+  vector<Chromosome> fathers, mothers;
+  for (unsigned int pair=0 ; pair<pair_count ; ++pair) {
+    fathers.push_back(Chromosome(parents.begin() + 2 * pair * length,
+				 parents.begin() + (2 * pair + 1) * length));
+    mothers.push_back(Chromosome(parents.begin() + (2 * pair + 1) * length,
+				 parents.begin() + (2 * pair + 2) * length));
+  }
+
+  TwoPointCrossover crossover(generate);
+  vector<Chromosome> offspring;
+  const double virtual_two_point = nanoseconds_per_pair(pair_count, [&] () {
+      for (unsigned int pair=0 ; pair<pair_count ; ++pair) {
+	offspring.clear();
+	crossover(fathers[pair], mothers[pair], offspring);
+	sink += offspring[0][0];
+      }
+    });
+
+  const double one_point = time_operator(OnePointOperator(generate), parents, children, pair_count, length);
+  const double two_point = time_operator(TwoPointOperator(generate), parents, children, pair_count, length);
+  const double uniform = time_operator(UniformOperator(generate), parents, children, pair_count, length);
+  const double interval = time_operator(IntervalOperator(generate, input_count), parents, children, pair_count, length);
+
+  cout << fixed << setprecision(1)
+       << setw(7) << input_count
+       << setw(9) << pair_count
+       << setw(14) << virtual_two_point
+       << setw(11) << one_point
+       << setw(11) << two_point
+       << setw(11) << uniform
+       << setw(11) << interval
+       << setw(10) << setprecision(2) << virtual_two_point / two_point
+       << endl;
+}
+
+
+int
+main(int argc, char** argv)
+{
+  const unsigned int pair_count = argc > 1 ? std::atoi(argv[1]) : 256;
+  Randomizer generate(20231017);
+
+  cout << "Crossover time per pair of parents (ns)" << endl
+       << setw(7) << "Inputs"
+       << setw(9) << "Pairs"
+       << setw(14) << "Virtual 2-pt"
+       << setw(11) << "1-point"
+       << setw(11) << "2-point"
+       << setw(11) << "Uniform"
+       << setw(11) << "Interval"
+       << setw(10) << "Speedup"
+       << endl;
+
+  for (unsigned int input_count: { 1, 2, 4, 8, 16, 32, 64 }) {
+    benchmark(input_count, pair_count, generate);
+  }
+
+  return 0;
+}
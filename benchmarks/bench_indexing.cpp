@@ -0,0 +1,156 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*
+ * Compares the linear scan of a MetaRulePool (using the fastest match
+ * kernel) with the premise indexes, for rules of increasing width.
+ * The grid index wins when rules are narrow compared to the domain,
+ * the linear scan wins when most rules match anyway.
+ *
+ * Usage: bench_indexing [maximum rule count]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "rule.h"
+#include "matching.h"
+
+
+using namespace std;
+using namespace xcsf;
+
+
+static const double MINIMUM_DURATION = 0.2; // seconds
+
+static volatile unsigned int sink = 0;
+
+
+double
+microseconds_per_query(const vector<Vector>& queries,
+		       const std::function<void (const Vector&)>& match)
+{
+  typedef chrono::steady_clock Clock;
+
+  unsigned int count = 0;
+  const Clock::time_point start = Clock::now();
+  double elapsed = 0;
+  do {
+    match(queries[count % queries.size()]);
+    ++count;
+    elapsed = chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < MINIMUM_DURATION);
+
+  return 1e6 * elapsed / count;
+}
+
+
+double
+time_pool(MetaRulePool& pool, PremiseIndex* index, const vector<Vector>& queries)
+{
+  Bitmask matches;
+  pool.index_with(index);
+  const double duration = microseconds_per_query(queries, [&] (const Vector& input) {
+      pool.match(input, matches);
+      sink += matches.words()[0] & 1;
+    });
+  pool.index_with(nullptr);
+  return duration;
+}
+
+
+void
+benchmark(unsigned int input_count,
+	  unsigned int rule_count,
+	  unsigned int spread,
+	  const Randomizer& generate)
+{
+  MetaRulePool pool(Dimensions(input_count, 1));
+  for (unsigned int slot=0 ; slot<rule_count ; ++slot) {
+    vector<Level> encoding;
+    for (unsigned int index=0 ; index<input_count ; ++index) {
+      Value centre = generate.unsigned_int(0, Value::MAXIMUM + 1);
+      Value lower = centre - generate.unsigned_int(0, spread + 1);
+      Value upper = centre + generate.unsigned_int(0, spread + 1);
+      encoding.push_back(static_cast<unsigned int>(lower));
+      encoding.push_back(static_cast<unsigned int>(upper));
+    }
+    encoding.push_back(50);
+    pool.acquire(encoding, Performance());
+  }
+
+  vector<Vector> queries;
+  for (unsigned int query=0 ; query<64 ; ++query) {
+    vector<unsigned int> values;
+    for (unsigned int index=0 ; index<input_count ; ++index) {
+      values.push_back(generate.unsigned_int(0, Value::MAXIMUM + 1));
+    }
+    queries.push_back(Vector(values));
+  }
+
+  const double linear = time_pool(pool, nullptr, queries);
+
+  ValueIndex value_index(input_count);
+  const double by_value = time_pool(pool, &value_index, queries);
+
+  GridIndex grid_index(input_count);
+  const double grid = time_pool(pool, &grid_index, queries);
+
+  cout << fixed << setprecision(2)
+       << setw(7) << input_count
+       << setw(10) << rule_count
+       << setw(8) << spread
+       << setw(12) << linear
+       << setw(12) << by_value
+       << setw(12) << grid
+       << setw(10) << linear / grid
+       << endl;
+}
+
+
+int
+main(int argc, char** argv)
+{
+  const unsigned int maximum_rules = argc > 1 ? std::atoi(argv[1]) : 100000;
+  Randomizer generate(20231017);
+
+  cout << "Matching time per input (us)" << endl
+       << setw(7) << "Inputs"
+       << setw(10) << "Rules"
+       << setw(8) << "Spread"
+       << setw(12) << "Linear"
+       << setw(12) << "Value"
+       << setw(12) << "Grid"
+       << setw(10) << "Speedup"
+       << endl;
+
+  for (unsigned int input_count: { 1, 2, 4, 8 }) {
+    for (unsigned int rule_count=1000 ; rule_count<=maximum_rules ; rule_count *= 10) {
+      for (unsigned int spread: { 2, 10, 25, 50 }) {
+	benchmark(input_count, rule_count, spread, generate);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*
+ * Compares the rule-by-rule matching (Rule::is_triggered_by) with the
+ * match kernels scanning the columns of a MetaRulePool, including the
+ * fastest kernel specialised for the number of inputs.
+ *
+ * Usage: bench_matching [maximum rule count]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "rule.h"
+#include "matching.h"
+
+
+using namespace std;
+using namespace xcsf;
+
+
+static const double MINIMUM_DURATION = 0.2; // seconds
+
+static volatile unsigned int sink = 0;
+
+
+double
+microseconds_per_query(const vector<Vector>& queries,
+		       const std::function<void (const Vector&)>& match)
+{
+  typedef chrono::steady_clock Clock;
+
+  unsigned int count = 0;
+  const Clock::time_point start = Clock::now();
+  double elapsed = 0;
+  do {
+    match(queries[count % queries.size()]);
+    ++count;
+    elapsed = chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < MINIMUM_DURATION);
+
+  return 1e6 * elapsed / count;
+}
+
+
+void
+benchmark(unsigned int input_count, unsigned int rule_count, const Randomizer& generate)
+{
+  vector<Rule> rules;
+  Columns lower_bounds(input_count, vector<Level>(rule_count));
+  Columns upper_bounds(input_count, vector<Level>(rule_count));
+  rules.reserve(rule_count);
+
+  for (unsigned int slot=0 ; slot<rule_count ; ++slot) {
+    vector<Interval> premises;
+    for (unsigned int index=0 ; index<input_count ; ++index) {
+      Value centre = generate.unsigned_int(0, Value::MAXIMUM + 1);
+      Value lower = centre - generate.unsigned_int(0, 50);
+      Value upper = centre + generate.unsigned_int(0, 50);
+      premises.push_back(Interval(lower, upper));
+      lower_bounds[index][slot] = static_cast<unsigned int>(lower);
+      upper_bounds[index][slot] = static_cast<unsigned int>(upper);
+    }
+    rules.push_back(Rule(premises, { 50 }));
+  }
+
+  vector<Vector> queries;
+  for (unsigned int query=0 ; query<64 ; ++query) {
+    vector<unsigned int> values;
+    for (unsigned int index=0 ; index<input_count ; ++index) {
+      values.push_back(generate.unsigned_int(0, Value::MAXIMUM + 1));
+    }
+    queries.push_back(Vector(values));
+  }
+
+  const double rule_by_rule = microseconds_per_query(queries, [&] (const Vector& input) {
+      for (auto& each_rule: rules) {
+	sink += each_rule.is_triggered_by(input);
+      }
+    });
+
+  Bitmask matches(rule_count);
+  auto time_kernel = [&] (MatchKernel kernel) {
+    return microseconds_per_query(queries, [&] (const Vector& input) {
+	matches.reset(rule_count);
+	kernel(lower_bounds, upper_bounds, input, matches);
+	sink += matches.words()[0] & 1;
+      });
+  };
+
+  const double scalar = time_kernel(&MatchKernels::scalar);
+  const double sse4 = MatchKernels::supports_sse4() ? time_kernel(&MatchKernels::sse4) : 0;
+  const double avx2 = MatchKernels::supports_avx2() ? time_kernel(&MatchKernels::avx2) : 0;
+  const double specialised = time_kernel(MatchKernels::fastest(input_count));
+
+  cout << fixed << setprecision(2)
+       << setw(7) << input_count
+       << setw(10) << rule_count
+       << setw(15) << rule_by_rule
+       << setw(12) << scalar
+       << setw(12) << sse4
+       << setw(12) << avx2
+       << setw(13) << specialised
+       << setw(10) << rule_by_rule / specialised
+       << endl;
+}
+
+
+int
+main(int argc, char** argv)
+{
+  const unsigned int maximum_rules = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  Randomizer generate(20231017);
+
+  cout << "Matching time per input (us)" << endl
+       << setw(7) << "Inputs"
+       << setw(10) << "Rules"
+       << setw(15) << "Rule-by-rule"
+       << setw(12) << "Scalar"
+       << setw(12) << "SSE4.1"
+       << setw(12) << "AVX2"
+       << setw(13) << "Specialised"
+       << setw(10) << "Speedup"
+       << endl;
+
+  for (unsigned int input_count: { 1, 2, 4, 8, 16, 32 }) {
+    for (unsigned int rule_count=1000 ; rule_count<=maximum_rules ; rule_count *= 10) {
+      benchmark(input_count, rule_count, generate);
+    }
+  }
+
+  return 0;
+}
@@ -18,21 +18,46 @@
 
 
 
+#include <sstream>
+#include <stdexcept>
+
 #include "agent.h"
 
 
 using namespace xcsf;
 
 
+const unsigned int Agent::DEFAULT_WINDOW;
+
+
 Agent::Agent(const Evolution&		evolution,
 	     const Covering&		convering,
-	     const RewardFunction&	reward)
+	     const RewardFunction&	reward,
+	     unsigned int		window)
   : _evolution(evolution)
   , _cover_for(convering)
   , _reward(reward)
   , _rules()
-  , _rules_to_reward()
+  , _matches()
+  , _match_set()
+  , _predictions()
+  , _pending(window)
+  , _next_ticket(0)
+  , _action_set()
 {
+  if (window == 0) {
+    std::stringstream message;
+    message << "Agents must keep at least one action set, but got a window of " << window << ".";
+    throw std::invalid_argument(message.str());
+  }
+
+  // Action sets never outgrow the rule set: reserving up front keeps
+  // predictions free of allocations
+  for (auto& each_pending: _pending) {
+    each_pending.is_open = false;
+    each_pending.action_set.reserve(_rules.capacity());
+  }
+  _action_set.reserve(_rules.capacity());
   _evolution.initialise(_rules);
 }
 
@@ -44,23 +69,89 @@ Agent::~Agent()
 const Vector&
 Agent::predict(const Vector& input)
 {
-  ActivationGroup active_rules(_rules, input);
-  if (active_rules.is_empty()) {
+  // Evolve first, so that the rules released by the evolution never
+  // appear in the rules to reward
+  _evolution.evolve(_rules);
+
+  collect_matches(input);
+  if (_match_set.empty()) {
+    _evolution.make_room(_rules, _cover_for.strength());
     _cover_for(_rules, input);
-    active_rules = ActivationGroup(_rules, input);
+    collect_matches(input);
   }
 
-  PredictionGroup predictions(active_rules);
-  _rules_to_reward = predictions.rules_to_reward();
-  _evolution.evolve(_rules);
-  return predictions.most_rewarding();
+  if (_match_set.empty()) {
+    _predictions.clear();
+  } else {
+    _predictions.select(_rules.pool(), SlotSpan(_match_set));
+  }
+  issue_ticket();
+  return _predictions.prediction();
+}
+
+
+void
+Agent::issue_ticket(void)
+{
+  PendingReward& pending = _pending[_next_ticket % _pending.size()];
+  pending.ticket = _next_ticket++;
+  pending.is_open = true;
+  pending.action_set.clear();
+  for (auto each_slot: _predictions.action_set()) {
+    pending.action_set.push_back(_rules.pool().handle(each_slot));
+  }
+}
+
+
+Ticket
+Agent::ticket(void) const
+{
+  return _next_ticket - 1;
+}
+
+
+void
+Agent::collect_matches(const Vector& input)
+{
+  _match_set.clear();
+  if (_rules.is_empty()) return;
+
+  _rules.pool().match(input, _matches);
+  for (auto each_slot: _rules.slots()) {
+    if (_matches[each_slot]) {
+      _match_set.push_back(each_slot);
+    }
+  }
 }
 
 
 void
 Agent::reward(double prize)
 {
-  _reward(prize, _rules_to_reward);
+  if (_next_ticket == 0) return;
+
+  reward(ticket(), prize);
+}
+
+
+bool
+Agent::reward(Ticket ticket, double prize)
+{
+  PendingReward& pending = _pending[ticket % _pending.size()];
+  if (not pending.is_open or pending.ticket != ticket) return false;
+  pending.is_open = false;
+
+  _action_set.clear();
+  for (auto each_handle: pending.action_set) {
+    if (_rules.pool().is_current(each_handle)) {
+      _action_set.push_back(each_handle.slot);
+    }
+  }
+  if (_action_set.empty()) return true;
+
+  _reward(prize, _rules.pool(), SlotSpan(_action_set));
+  _evolution.evolve_niche(_rules, SlotSpan(_action_set));
+  return true;
 }
 
 
@@ -29,12 +29,28 @@
 
 namespace xcsf {
 
+  /**
+   * Number of a prediction, counted from 0, which credits its action
+   * set once the reward is known
+   */
+  typedef unsigned long Ticket;
+
+
+  /**
+   * Learning agent. Each prediction gets a ticket, and the agent keeps
+   * the action sets of the last tickets, up to a window, so that
+   * clients may stream inputs and send the rewards later on. Rules
+   * released meanwhile, as the rule set evolved, are not credited.
+   */
   class Agent
   {
   public:
+    static const unsigned int DEFAULT_WINDOW = 64;
+
     Agent(const Evolution&	evolution,
 	  const Covering&	covering,
-	  const RewardFunction& reward);
+	  const RewardFunction& reward,
+	  unsigned int		window = DEFAULT_WINDOW);
 
     virtual ~Agent();
 
@@ -45,18 +61,42 @@ namespace xcsf {
     virtual const Vector&
       predict(const Vector& input);
 
+    /** Ticket of the last prediction */
+    Ticket
+      ticket(void) const;
+
+    /** Credits the last prediction */
     void
       reward(double reward);
 
+    /** False if the ticket was already credited or left the window */
+    bool
+      reward(Ticket ticket, double reward);
+
     void
       display_on(std::ostream& out) const;
 
   private:
+    struct PendingReward
+    {
+      Ticket			ticket;
+      bool			is_open;
+      std::vector<RuleHandle>	action_set;
+    };
+
+    void collect_matches(const Vector& input);
+    void issue_ticket(void);
+
     const Evolution&		_evolution;
     const Covering& 		_cover_for;
     const RewardFunction&	_reward;
     RuleSet			_rules;
-    RuleSet			_rules_to_reward;
+    Bitmask			_matches;
+    std::vector<unsigned int>	_match_set;
+    PredictionArray		_predictions;
+    std::vector<PendingReward>	_pending;
+    Ticket			_next_ticket;
+    std::vector<unsigned int>	_action_set;
 
   };
 
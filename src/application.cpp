@@ -27,10 +27,15 @@ Application::Application(istream&		input,
 			 ostream&		output,
 			 const Evolution&	evolution,
 			 const Covering&	covering,
-			 const RewardFunction&	reward)
-  : _encoder(new Encoder(output))
+			 const RewardFunction&	reward,
+			 Protocol		protocol)
+  : _encoder(protocol == Protocol::BINARY
+	     ? new BinaryEncoder(output)
+	     : new Encoder(output))
   , _controller(new AgentController(*_encoder, evolution, covering, reward))
-  , _decoder(new Decoder(input, *_controller))
+  , _decoder(protocol == Protocol::BINARY
+	     ? new BinaryDecoder(input, *_controller, output)
+	     : new Decoder(input, *_controller))
 {
 }
 
@@ -45,5 +50,6 @@ Application::~Application()
 
 void
 Application::run(void) const {
+  _encoder->show_banner();
   _decoder->decode();
 }
@@ -27,6 +27,10 @@
 
 namespace xcsf {
 
+  /** Text lines, or length-prefixed binary frames */
+  enum class Protocol { TEXT, BINARY };
+
+
   class Application
   {
   public:
@@ -34,7 +38,8 @@ namespace xcsf {
 		ostream&		output,
 		const Evolution&	evolution,
 		const Covering&	convering,
-		const RewardFunction&	reward);
+		const RewardFunction&	reward,
+		Protocol		protocol = Protocol::TEXT);
 
     ~Application();
 
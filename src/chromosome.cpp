@@ -30,7 +30,7 @@ xcsf::operator << (ostream& out, const Chromosome& chromosome)
 {
   out << "{ ";
   for (unsigned int locus=0 ; locus<chromosome.size() ; ++locus) {
-    out << chromosome[locus];
+    out << static_cast<unsigned int>(chromosome[locus]);
     if (locus < chromosome.size()-1) out << ", ";
   }
   out << " }";
@@ -47,7 +47,28 @@ Codec::Codec(MetaRulePool& rules)
 Chromosome
 Codec::encode(const MetaRule& rule) const
 {
-  return Chromosome(rule.as_vector());
+  Chromosome genome;
+  encode(rule, genome);
+  return genome;
+}
+
+
+void
+Codec::encode(const MetaRule& rule, Chromosome& genome) const
+{
+  const MetaRulePool& pool = rule.pool();
+  const Dimensions& dimensions = pool.dimensions();
+  const unsigned int slot = rule.slot();
+
+  genome.resize(2 * dimensions.input_count() + dimensions.output_count());
+  Allele* allele = genome.data();
+  for (unsigned int index=0 ; index<dimensions.input_count() ; ++index) {
+    *allele++ = pool.lower_bounds(index)[slot];
+    *allele++ = pool.upper_bounds(index)[slot];
+  }
+  for (unsigned int index=0 ; index<dimensions.output_count() ; ++index) {
+    *allele++ = pool.conclusions(index)[slot];
+  }
 }
 
 
@@ -68,24 +89,5 @@ Codec::decode(const Dimensions&	dimensions,
     throw invalid_argument(error.str());
   }
 
-  vector<Interval> constraints;
-  for (unsigned int index=0 ; index < dimensions.input_count() ; ++index) {
-    unsigned int lower_bound = values[index * 2];
-    unsigned int upper_bound = values[index * 2 + 1];
-    if (lower_bound > upper_bound) {
-      std::swap(lower_bound, upper_bound);
-    }
-    constraints.push_back(Interval(lower_bound, upper_bound));
-  }
-
-  vector<unsigned int> prediction;
-  for (unsigned int index=dimensions.input_count()*2
-	 ; index<values.size()
-	 ; ++index) {
-    prediction.push_back(values[index]);
-  }
-
-  Vector p = Vector(prediction);
-  MetaRule *result = _rules.acquire(Rule(constraints, p), performance);
-  return result;
+  return _rules.acquire(values, performance);
 }
@@ -30,7 +30,15 @@
 namespace xcsf {
 
   
-  typedef unsigned int Allele;
+  /**
+   * Gene value, stored as compactly as a value in a pool column
+   */
+  typedef Level Allele;
+
+  /**
+   * Position of a gene in a chromosome
+   */
+  typedef unsigned int Locus;
 
   typedef std::vector<Allele> Chromosome;
 
@@ -50,6 +58,10 @@ namespace xcsf {
     Chromosome
       encode(const MetaRule& rule) const;
 
+    /** Reads the rule straight from the pool columns, reusing the genome storage */
+    void
+      encode(const MetaRule& rule, Chromosome& genome) const;
+
     MetaRule*
       decode(const Dimensions& dimensions,
 	     const Chromosome& chromosome,
@@ -26,6 +26,9 @@ using namespace std;
 using namespace xcsf;
 
 
+const unsigned int Value::MAXIMUM;
+
+
 Value::Value(int value):
   Value(static_cast<unsigned>(value))
 {}
@@ -35,14 +38,27 @@ Value::Value(unsigned int value)
   if (value > MAXIMUM)
     throw std::invalid_argument("A value cannot exceed the maximum");
   
-  _value = value;
+  _value = static_cast<Level>(value);
 }
 
+Value::Value()
+  : _value(0)
+{}
+
 Value::Value(const Value& prototype)
 {
   _value = prototype._value;
 }
 
+
+Value
+Value::unchecked(unsigned int value)
+{
+  Value result;
+  result._value = static_cast<Level>(value);
+  return result;
+}
+
 Value::~Value()
 {}
 
@@ -104,7 +120,7 @@ Value::operator unsigned int(void) const
 
 std::ostream&
 xcsf::operator << (std::ostream& out, const Value& value) {
-  out << value._value;
+  out << static_cast<unsigned int>(value._value);
   return out;
 }
 
@@ -114,7 +130,7 @@ xcsf::operator + (const Value& left, const Value& right) {
   if (sum > Value::MAXIMUM) {
     sum = Value::MAXIMUM;
   }
-  return Value(sum); 
+  return Value::unchecked(sum);
 }
 
 const Value
@@ -123,26 +139,36 @@ xcsf::operator - (const Value& left, const Value& right) {
   if (left._value > right._value) {
     sum = left._value - right._value;
   }
-  return Value(sum); 
+  return Value::unchecked(sum);
 }
 
 
-Vector::Vector(unsigned int dimension_count):
-  _values(dimension_count, 0)
-{}
+const unsigned int Vector::INLINE_CAPACITY;
+
+
+Vector::Vector(unsigned int dimension_count)
+  : _size(0)
+  , _values(_inline)
+{
+  allocate(dimension_count);
+}
 
 
 Vector::Vector(const vector<int>& values)
-  :_values(values.size(), 0)
+  : _size(0)
+  , _values(_inline)
 {
+  allocate(values.size());
   for (unsigned int index=0 ; index<values.size() ; ++index) {
     _values[index] = values[index];
   }   
 }
 
-Vector::Vector(const vector<unsigned int>& values):
-  _values(values.size(), 0)
+Vector::Vector(const vector<unsigned int>& values)
+  : _size(0)
+  , _values(_inline)
 {
+  allocate(values.size());
   for (unsigned int index=0 ; index<values.size() ; index++)
     {
       _values[index] = values[index];
@@ -150,9 +176,11 @@ Vector::Vector(const vector<unsigned int>& values):
 }
 
 
-Vector::Vector(initializer_list<int> values):
-  _values(values.size(), 0)
+Vector::Vector(initializer_list<int> values)
+  : _size(0)
+  , _values(_inline)
 {
+  allocate(values.size());
   for (initializer_list<int>::iterator each = values.begin() ;
        each != values.end();
        ++each)
@@ -164,34 +192,91 @@ Vector::Vector(initializer_list<int> values):
 
 
 Vector::Vector(const Vector& prototype)
-  :_values(prototype._values)
-{}
+  : _size(0)
+  , _values(_inline)
+{
+  allocate(prototype._size);
+  std::copy(prototype._values, prototype._values + _size, _values);
+}
+
+
+Vector::Vector(Vector&& prototype)
+  : _size(0)
+  , _values(_inline)
+{
+  *this = std::move(prototype);
+}
   
 
 Vector::~Vector()
-{}
+{
+  release();
+}
+
+
+void
+Vector::allocate(unsigned int size)
+{
+  _size = size;
+  _values = (size <= INLINE_CAPACITY) ? _inline : new Value[size];
+}
+
+
+void
+Vector::release(void)
+{
+  if (_values != _inline) {
+    delete [] _values;
+  }
+  _size = 0;
+  _values = _inline;
+}
 
 
 void
 Vector::operator = (const Vector& other)
 {
-  _values = other._values;
+  if (this == &other) return;
+
+  if (_size != other._size) {
+    release();
+    allocate(other._size);
+  }
+  std::copy(other._values, other._values + _size, _values);
 }  
 
 
+void
+Vector::operator = (Vector&& other)
+{
+  if (this == &other) return;
+
+  release();
+  if (other._values == other._inline) {
+    allocate(other._size);
+    std::copy(other._values, other._values + _size, _values);
+  } else {
+    _size = other._size;
+    _values = other._values;
+    other._size = 0;
+    other._values = other._inline;
+  }
+}
+
+
 unsigned int
 Vector::size(void) const
 {
-  return _values.size();
+  return _size;
 }
 
 
 bool
 Vector::operator == (const Vector& other) const
 {
-  if (_values.size() != other._values.size()) return false;
+  if (_size != other._size) return false;
   
-  for(unsigned int index=0 ; index<_values.size() ; index++) {
+  for(unsigned int index=0 ; index<_size ; index++) {
     if (_values[index] != other._values[index]) return false;
   }
   
@@ -212,10 +297,17 @@ Vector::operator [] (unsigned int index) const
 }
 
 
+Value&
+Vector::operator [] (unsigned int index)
+{
+  return _values[index];
+}
+
+
 bool
 Vector::operator < (const Vector& other) const
 {
-  for (unsigned int index=0 ; index<_values.size() ; ++index) {
+  for (unsigned int index=0 ; index<_size ; ++index) {
     if (_values[index] == other._values[index]) continue;
     return _values[index] < other._values[index];
   }
@@ -226,10 +318,13 @@ Vector::operator < (const Vector& other) const
 ostream&
 xcsf::operator << (ostream& out, const Vector& vector) {
   out << "[";
-  for(unsigned int index=0 ; index<vector._values.size()-1 ; ++index) {
+  for(unsigned int index=0 ; index+1<vector._size ; ++index) {
     out << vector._values[index] << ", ";
   }
-  out << vector._values.back() <<  "]";
+  if (vector._size > 0) {
+    out << vector._values[vector._size - 1];
+  }
+  out <<  "]";
   return out;
 }
 
@@ -21,14 +21,35 @@
 #define XCSF_CONTEXT_H
 
 
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <vector>
 #include <iostream>
 #include <stdexcept>
 
 
+/**
+ * Largest value an input or an output may take. Build with, for
+ * instance, -DXCSF_VALUE_MAXIMUM=1000 for a finer resolution.
+ */
+#ifndef XCSF_VALUE_MAXIMUM
+#define XCSF_VALUE_MAXIMUM 100
+#endif
+
+
 namespace xcsf
 {
 
+  /**
+   * Raw storage of a value, as kept in the columns of a MetaRulePool:
+   * a byte up to 255, two bytes up to 65535
+   */
+  typedef std::conditional<(XCSF_VALUE_MAXIMUM <= 0xFF),
+			   std::uint8_t,
+			   std::uint16_t>::type Level;
+
+
   class Value
   {
   public:
@@ -38,6 +59,12 @@ namespace xcsf
     Value(const Value& prototype);
     ~Value();
 
+    /**
+     * Builds a value known to be in range, such as one read back from
+     * the columns of a pool, without checking it against the maximum
+     */
+    static Value unchecked(unsigned int value);
+
     Value& operator = (const Value& other);
  
     explicit operator unsigned int (void) const;
@@ -54,40 +81,63 @@ namespace xcsf
 
     friend std::ostream& operator << (std::ostream& out, const Value& value);
 
-    static const unsigned int MAXIMUM = 100;
+    static const unsigned int MAXIMUM = XCSF_VALUE_MAXIMUM;
   
   private:
-  
-    unsigned int _value;
+    friend class Vector;
+
+    Value();
+
+    Level _value;
   
   };
+
+
+  static_assert(Value::MAXIMUM <= std::numeric_limits<std::uint16_t>::max(),
+		"Values must fit in a Level");
+  static_assert(sizeof(Value) == sizeof(Level), "Values must be as compact as Levels");
    
 
+  /**
+   * Fixed-size sequence of values, stored inline up to INLINE_CAPACITY
+   * values, so that copying typical inputs and predictions does not
+   * touch the heap
+   */
   class Vector
   {
   public:
+    static const unsigned int INLINE_CAPACITY = 16;
+
     Vector(unsigned int dimension_count);
     Vector(std::initializer_list<int> values);
     Vector(const std::vector<int>& values);
     Vector(const std::vector<unsigned int>& values);
     Vector(const Vector& other);
+    Vector(Vector&& other);
     ~Vector();
 
     void operator = (const Vector& other);
+    void operator = (Vector&& other);
     bool operator == (const Vector& other) const;
     bool operator != (const Vector& other) const;
     bool operator < (const Vector& other) const;
   
     unsigned int size(void) const;
     const Value& operator [] (unsigned int index) const;
+    Value& operator [] (unsigned int index);
 
 
     static Vector parse(const std::string& text);
   
   private:
     friend std::ostream& operator << (std::ostream& out, const Vector& vector);
-  
-    std::vector<Value> _values;
+
+    void allocate(unsigned int size);
+    void release(void);
+
+    unsigned int _size;
+    Value* _values;
+    Value _inline[INLINE_CAPACITY];
   
   };
 
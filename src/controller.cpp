@@ -17,6 +17,7 @@
  */
 
 
+#include <cstring>
 #include <sstream>
 
 #include "controller.h"
@@ -31,12 +32,15 @@ Controller::~Controller()
 
 
 const string SEPARATOR = ":";
+const char BATCH_SEPARATOR = ';';
 
 
 enum Command {
   Reward,
   Predict,
-  Show
+  Show,
+  BatchReward,
+  BatchPredict
 };
 
 
@@ -46,6 +50,8 @@ parse(const string& text)
   if (text == "R") return Reward;
   if (text == "P") return Predict;
   if (text == "S") return Show;
+  if (text == "BR") return BatchReward;
+  if (text == "BP") return BatchPredict;
   throw invalid_argument("Unknown command!");
 }
 
@@ -64,10 +70,29 @@ validate(const string& line, size_t position)
 
 Decoder::Decoder(istream& source, Controller& target)
   :_source(source),
-   _target(target)
+   _target(target),
+   _contexts(),
+   _values()
 {}
 
 
+Decoder::~Decoder()
+{}
+
+
+void
+Decoder::reward(const string& text)
+{
+  // Either "R:<value>", for the last prediction, or "R:<ticket>:<value>"
+  size_t position = text.find(SEPARATOR, 0);
+  if (position == string::npos) {
+    _target.reward(stod(text));
+  } else {
+    _target.reward(stoul(text.substr(0, position)), stod(text.substr(position+1)));
+  }
+}
+
+
 void
 Decoder::decode(void)
 {
@@ -79,7 +104,7 @@ Decoder::decode(void)
     string value = line.substr(position+1);
     switch(command) {
     case Reward:
-      _target.reward(stod(value));
+      reward(value);
       break;
     case Predict:
       _target.predict(Vector::parse(value));
@@ -87,9 +112,201 @@ Decoder::decode(void)
     case Show:
       _target.show();
       break;
+    case BatchReward:
+      reward_all(value);
+      break;
+    case BatchPredict:
+      predict_all(value);
+      break;
+    }
+  }
+
+}
+
+
+string
+next_item(const string& text, size_t& start)
+{
+  size_t end = text.find(BATCH_SEPARATOR, start);
+  if (end == string::npos) end = text.size();
+  if (end == start) {
+    stringstream error;
+    error << "Invalid batch '" << text << "'. "
+	  << "Check it has no empty item around '" << BATCH_SEPARATOR << "'.";
+    throw invalid_argument(error.str());
+  }
+
+  const string item = text.substr(start, end - start);
+  start = end + 1;
+  return item;
+}
+
+
+void
+Decoder::predict_all(const string& text)
+{
+  // "BP:(1, 2);(3, 4);..."
+  _contexts.clear();
+  size_t start = 0;
+  do {
+    _contexts.push_back(Vector::parse(next_item(text, start)));
+  } while (start <= text.size());
+  _target.predict_all(_contexts);
+}
+
+
+void
+Decoder::reward_all(const string& text)
+{
+  // "BR:<first ticket>:<value>;<value>;..."
+  size_t position = text.find(SEPARATOR, 0);
+  validate(text, position);
+
+  _values.clear();
+  size_t start = position + 1;
+  do {
+    _values.push_back(stod(next_item(text, start)));
+  } while (start <= text.size());
+  _target.reward_all(stoul(text.substr(0, position)), _values);
+}
+
+
+std::uint64_t
+read_little_endian(const char* bytes, unsigned int size)
+{
+  std::uint64_t result = 0;
+  for (unsigned int index=size ; index>0 ; --index) {
+    result = (result << 8) | static_cast<unsigned char>(bytes[index-1]);
+  }
+  return result;
+}
+
+
+void
+write_little_endian(std::uint64_t value, unsigned int size, std::vector<char>& bytes)
+{
+  for (unsigned int index=0 ; index<size ; ++index) {
+    bytes.push_back(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+
+BinaryDecoder::BinaryDecoder(istream& source, Controller& target, ostream& replies)
+  : Decoder(source, target)
+  , _replies(replies)
+  , _payload()
+{}
+
+
+BinaryDecoder::~BinaryDecoder()
+{}
+
+
+void
+BinaryDecoder::decode(void)
+{
+  char command;
+  std::uint32_t length;
+  while (read_header(command, length)) {
+    read_payload(length);
+    // Frames already stream, so batches would save nothing there
+    switch(command) {
+    case frame::REWARD:
+      reward();
+      break;
+    case frame::PREDICT:
+      predict();
+      break;
+    case frame::SHOW:
+      _target.show();
+      break;
+    default:
+      throw invalid_argument("Unknown command!");
     }
   }
+  _replies.flush();
+}
+
+
+bool
+BinaryDecoder::read_header(char& command, std::uint32_t& length)
+{
+  if (_source.rdbuf()->in_avail() <= 0) {
+    _replies.flush();
+  }
+
+  char header[frame::HEADER_SIZE];
+  _source.read(header, frame::HEADER_SIZE);
+  if (_source.gcount() == 0) return false;
+  if (_source.gcount() != static_cast<std::streamsize>(frame::HEADER_SIZE)) {
+    throw invalid_argument("Truncated frame header!");
+  }
+
+  command = header[0];
+  length = static_cast<std::uint32_t>(read_little_endian(header + 1, 4));
+  return true;
+}
+
 
+void
+BinaryDecoder::read_payload(std::uint32_t length)
+{
+  _payload.resize(length);
+  if (length == 0) return;
+
+  _source.read(_payload.data(), length);
+  if (_source.gcount() != static_cast<std::streamsize>(length)) {
+    stringstream error;
+    error << "Truncated frame: expected " << length << " bytes, but got "
+	  << _source.gcount() << ".";
+    throw invalid_argument(error.str());
+  }
+}
+
+
+void
+BinaryDecoder::predict(void)
+{
+  if (_payload.size() % frame::VALUE_SIZE != 0) {
+    stringstream error;
+    error << "Invalid input frame: " << _payload.size()
+	  << " bytes is not a whole number of values.";
+    throw invalid_argument(error.str());
+  }
+
+  const unsigned int count = _payload.size() / frame::VALUE_SIZE;
+  Vector input(count);
+  for (unsigned int index=0 ; index<count ; ++index) {
+    const char* bytes = _payload.data() + index * frame::VALUE_SIZE;
+    input[index] = Value(static_cast<unsigned int>(read_little_endian(bytes, frame::VALUE_SIZE)));
+  }
+  _target.predict(input);
+}
+
+
+void
+BinaryDecoder::reward(void)
+{
+  const bool has_ticket = _payload.size() == frame::TICKET_SIZE + frame::REWARD_SIZE;
+  if (_payload.size() != frame::REWARD_SIZE and not has_ticket) {
+    stringstream error;
+    error << "Invalid reward frame: expected " << frame::REWARD_SIZE
+	  << " or " << frame::TICKET_SIZE + frame::REWARD_SIZE
+	  << " bytes, but got " << _payload.size() << ".";
+    throw invalid_argument(error.str());
+  }
+
+  const char* bytes = _payload.data() + (has_ticket ? frame::TICKET_SIZE : 0);
+  const std::uint64_t bits = read_little_endian(bytes, frame::REWARD_SIZE);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+
+  if (has_ticket) {
+    _target.reward(read_little_endian(_payload.data(), frame::TICKET_SIZE), value);
+  } else {
+    _target.reward(value);
+  }
 }
 
 
@@ -102,12 +319,30 @@ Encoder::~Encoder()
 {}
 
 
+void
+Encoder::show_banner(void)
+{
+  _out << APPLICATION << " v" << VERSION << endl;
+}
+
+
 void
 Encoder::show_prediction(const Vector& prediction)
 {
   _out << prediction << endl;
 }
 
+void
+Encoder::show_predictions(const std::vector<Vector>& predictions)
+{
+  for (unsigned int index=0 ; index<predictions.size() ; ++index) {
+    if (index > 0) _out << BATCH_SEPARATOR;
+    _out << predictions[index];
+  }
+  _out << endl;
+}
+
+
 void
 Encoder::show(const Agent& agent)
 {
@@ -115,6 +350,62 @@ Encoder::show(const Agent& agent)
 }
 
 
+BinaryEncoder::BinaryEncoder(ostream& out)
+  : Encoder(out)
+  , _buffer()
+{}
+
+
+BinaryEncoder::~BinaryEncoder()
+{}
+
+
+void
+BinaryEncoder::show_banner(void)
+{}
+
+
+void
+BinaryEncoder::write_header(char command, std::uint32_t length)
+{
+  _buffer.clear();
+  _buffer.push_back(command);
+  write_little_endian(length, 4, _buffer);
+}
+
+
+void
+BinaryEncoder::show_prediction(const Vector& prediction)
+{
+  write_header(frame::PREDICT, prediction.size() * frame::VALUE_SIZE);
+  for (unsigned int index=0 ; index<prediction.size() ; ++index) {
+    write_little_endian(static_cast<unsigned int>(prediction[index]), frame::VALUE_SIZE, _buffer);
+  }
+  _out.write(_buffer.data(), _buffer.size());
+}
+
+
+void
+BinaryEncoder::show_predictions(const std::vector<Vector>& predictions)
+{
+  for (auto& each_prediction: predictions) {
+    show_prediction(each_prediction);
+  }
+}
+
+
+void
+BinaryEncoder::show(const Agent& agent)
+{
+  stringstream text;
+  agent.display_on(text);
+  const string rules = text.str();
+  write_header(frame::SHOW, rules.size());
+  _out.write(_buffer.data(), _buffer.size());
+  _out.write(rules.data(), rules.size());
+}
+
+
 AgentController::AgentController(Encoder&		encoder,
 				 const Evolution&	evolution,
 				 const Covering&	covering,
@@ -125,6 +416,7 @@ AgentController::AgentController(Encoder&		encoder,
   , _covering(covering)
   , _reward(reward)
   , _agents()
+  , _predictions()
 {
   _agents.push_back(new Agent(_evolution, _covering, _reward));
 }
@@ -153,6 +445,13 @@ AgentController::reward(double prize)
 }
 
 
+void
+AgentController::reward(Ticket ticket, double prize)
+{
+  _agents[0]->reward(ticket, prize);
+}
+
+
 void
 AgentController::predict(const Vector& context)
 {
@@ -166,3 +465,23 @@ AgentController::show(void) const
 {
   _encoder.show(*_agents[0]);
 }
+
+
+void
+AgentController::predict_all(const std::vector<Vector>& contexts)
+{
+  _predictions.clear();
+  for (auto& each_context: contexts) {
+    _predictions.push_back(_agents[0]->predict(each_context));
+  }
+  _encoder.show_predictions(_predictions);
+}
+
+
+void
+AgentController::reward_all(Ticket first, const std::vector<double>& values)
+{
+  for (unsigned int index=0 ; index<values.size() ; ++index) {
+    _agents[0]->reward(first + index, values[index]);
+  }
+}
@@ -21,6 +21,8 @@
 #define XCSF_CONTROLLER_H
 
 
+#include <cstdint>
+
 #include "agent.h"
 
 
@@ -33,23 +35,89 @@ namespace xcsf {
     virtual ~Controller();
 
     virtual void reward(double value) = 0;
+    virtual void reward(Ticket ticket, double value) = 0;
     virtual void predict(const Vector& context) = 0;
     virtual void show(void) const = 0;
 
+    /** Predicts for all the contexts, replying once for all */
+    virtual void predict_all(const std::vector<Vector>& contexts) = 0;
+
+    /** Credits the tickets from the first one on, one per value */
+    virtual void reward_all(Ticket first, const std::vector<double>& values) = 0;
+
   };
 
 
+  /**
+   * Wire format of the binary protocol. Each frame starts with a fixed
+   * header, that is a command byte followed by the length of the
+   * payload, as a 32-bit little-endian integer. Payloads are:
+   *  - 'P', the values of the input or of the prediction, each as a
+   *    16-bit little-endian integer;
+   *  - 'R', the reward as a little-endian IEEE 754 double, preceded
+   *    by a 64-bit little-endian ticket, if any;
+   *  - 'S', nothing in requests, and the text of the rules in replies.
+   */
+  namespace frame {
+    const char PREDICT = 'P';
+    const char REWARD = 'R';
+    const char SHOW = 'S';
+
+    const unsigned int HEADER_SIZE = 5;
+    const unsigned int VALUE_SIZE = 2;
+    const unsigned int TICKET_SIZE = 8;
+    const unsigned int REWARD_SIZE = 8;
+  }
+
+
   class Decoder
   {
   public:
     Decoder(istream& source, Controller& target);
 
-    void decode(void);
+    virtual ~Decoder();
 
-  private:
+    virtual void decode(void);
+
+  protected:
     istream&	_source;
     Controller& _target;
 
+  private:
+    void reward(const string& text);
+    void predict_all(const string& text);
+    void reward_all(const string& text);
+
+    std::vector<Vector>	_contexts;
+    std::vector<double>	_values;
+
+  };
+
+
+  /**
+   * Decoder of binary frames. Replies are only flushed once all the
+   * requests received so far are decoded, so that a client streaming
+   * requests does not pay for a flush per reply.
+   */
+  class BinaryDecoder
+    : public Decoder
+  {
+  public:
+    BinaryDecoder(istream& source, Controller& target, ostream& replies);
+
+    virtual ~BinaryDecoder();
+
+    virtual void decode(void);
+
+  private:
+    bool read_header(char& command, std::uint32_t& length);
+    void read_payload(std::uint32_t length);
+    void predict(void);
+    void reward(void);
+
+    ostream&		_replies;
+    std::vector<char>	_payload;
+
   };
 
 
@@ -58,18 +126,53 @@ namespace xcsf {
   public:
     Encoder(ostream& out);
 
-    ~Encoder();
+    virtual ~Encoder();
 
-    void show_prediction(const Vector& prediction);
+    /** Name and version of the application, on a line of its own */
+    virtual void show_banner(void);
 
-    void show(const Agent& agent);
+    virtual void show_prediction(const Vector& prediction);
 
-  private:
+    /** All the predictions on a single line */
+    virtual void show_predictions(const std::vector<Vector>& predictions);
+
+    virtual void show(const Agent& agent);
+
+  protected:
     std::ostream& _out;
 
   };
 
 
+  /**
+   * Encoder of binary frames, which never flushes on its own
+   */
+  class BinaryEncoder
+    : public Encoder
+  {
+  public:
+    BinaryEncoder(ostream& out);
+
+    virtual ~BinaryEncoder();
+
+    /** None, as clients expect frames from the first byte on */
+    virtual void show_banner(void);
+
+    virtual void show_prediction(const Vector& prediction);
+
+    /** One frame per prediction */
+    virtual void show_predictions(const std::vector<Vector>& predictions);
+
+    virtual void show(const Agent& agent);
+
+  private:
+    void write_header(char command, std::uint32_t length);
+
+    std::vector<char>	_buffer;
+
+  };
+
+
   class AgentController: public Controller
   {
   public:
@@ -84,16 +187,23 @@ namespace xcsf {
 
     virtual void reward(double value);
 
+    virtual void reward(Ticket ticket, double value);
+
     virtual void predict(const Vector& context);
 
     virtual void show(void) const;
 
+    virtual void predict_all(const std::vector<Vector>& contexts);
+
+    virtual void reward_all(Ticket first, const std::vector<double>& values);
+
   private:
     Encoder&			_encoder;
     const Evolution&		_evolution;
     const Covering&		_covering;
     const RewardFunction&	_reward;
     vector<Agent*>		_agents;
+    std::vector<Vector>		_predictions;
 
   };
 
@@ -27,6 +27,13 @@ Covering::~Covering()
 {}
 
 
+unsigned int
+Covering::strength(void) const
+{
+  return 1;
+}
+
+
 AbstractCovering::AbstractCovering(MetaRulePool& pool, unsigned int strength)
   : _rule_pool(pool)
   , _strength(strength)
@@ -53,11 +60,18 @@ AbstractCovering::rule_pool(void) const
 
 
 
+const unsigned int RandomCovering::DEFAULT_SPREAD;
+
+
 RandomCovering::RandomCovering(MetaRulePool&		pool,
 			       unsigned int		strength,
-			       const Randomizer&	randomizer)
+			       const Randomizer&	randomizer,
+			       unsigned int		spread)
   : AbstractCovering(pool, strength)
   , _generate(randomizer)
+  , _spread(spread)
+  , _spreads()
+  , _conclusions()
 {}
 
 
@@ -66,20 +80,21 @@ RandomCovering::operator () (RuleSet& rules, const Vector& context) const
 {
   for (unsigned int i=0 ; i<strength() ; ++i) {
 
+    const Dimensions& dimensions = rules.dimensions();
+    _spreads.resize(2 * dimensions.input_count());
+    _conclusions.resize(dimensions.output_count());
+    _generate.unsigned_ints(_spreads.data(), _spreads.size(), 0, _spread + 1);
+    _generate.unsigned_ints(_conclusions.data(), _conclusions.size(), 0, Value::MAXIMUM + 1);
+
     vector<Interval> premises;
-    for (unsigned int index=0 ; index<rules.dimensions().input_count() ; ++index) {
-      Value lower = context[index] - _generate.unsigned_int(0, 20);
-      Value upper = context[index] + _generate.unsigned_int(0, 20);
+    for (unsigned int index=0 ; index<dimensions.input_count() ; ++index) {
+      Value lower = context[index] - _spreads[2 * index];
+      Value upper = context[index] + _spreads[2 * index + 1];
       premises.push_back(Interval(lower, upper));
     }
 
-    vector<unsigned int> conclusion;
-    for (unsigned int index=0 ; index<rules.dimensions().output_count() ; ++index) {
-      conclusion.push_back(_generate.unsigned_int(0, Value::MAXIMUM));
-    }
-
-    MetaRule *rule = rule_pool().acquire(Rule(premises, conclusion), Performance(0, 0, 0));
-    rules.add(*rule);
+    MetaRule *rule = rule_pool().acquire(Rule(premises, _conclusions), Performance(0, 0, 0));
+    rules.merge(*rule);
   }
 
 }
@@ -36,6 +36,11 @@ namespace xcsf
       operator () (RuleSet& rules, const Vector& context)
       const = 0;
 
+    /** Most rules that a single covering may add, one by default */
+    virtual unsigned int
+      strength(void)
+      const;
+
   };
 
 
@@ -50,10 +55,11 @@ namespace xcsf
       operator () (RuleSet& rules, const Vector& context)
       const = 0;
 
+    virtual unsigned int strength(void) const;
+
   protected:
     AbstractCovering(MetaRulePool& pool, unsigned int strength=1);
 
-    unsigned int strength(void) const;
     MetaRulePool& rule_pool(void) const;
 
   private:
@@ -68,14 +74,24 @@ namespace xcsf
     : public AbstractCovering
   {
   public:
+    /**
+     * Largest distance between the covered input and the bounds of the
+     * new premises, a fifth of the value domain
+     */
+    static const unsigned int DEFAULT_SPREAD = Value::MAXIMUM / 5;
+
     RandomCovering(MetaRulePool&	pool,
 		   unsigned int	strength,
-		   const Randomizer&	randomizer);
+		   const Randomizer&	randomizer,
+		   unsigned int		spread = DEFAULT_SPREAD);
 
     virtual void operator () (RuleSet& rules, const Vector& context) const;
 
   private:
     const Randomizer& _generate;
+    unsigned int _spread;
+    mutable std::vector<unsigned int> _spreads;
+    mutable std::vector<unsigned int> _conclusions;
 
   };
 
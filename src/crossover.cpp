@@ -33,13 +33,13 @@ Crossover::~Crossover()
 
 TwoPointCrossover::TwoPointCrossover(const Randomizer& randomizer)
   : Crossover()
-  , _generate(randomizer)
+  , _cross(randomizer)
 {}
 
 
 TwoPointCrossover::TwoPointCrossover(const TwoPointCrossover& other)
   : Crossover(other)
-  , _generate(other._generate)
+  , _cross(other._cross)
 {}
 
 
@@ -48,7 +48,7 @@ TwoPointCrossover::~TwoPointCrossover()
 
 
 void
-validate(const Chromosome father, const Chromosome& mother)
+xcsf::validate_parents(const Chromosome& father, const Chromosome& mother)
 {
   if (father.empty() or mother.empty()) {
     throw invalid_argument("Empty chromosome!");
@@ -73,26 +73,12 @@ TwoPointCrossover::children_count(void) const
 void
 TwoPointCrossover::operator()(const Chromosome& father, const Chromosome& mother, vector<Chromosome>& children) const
 {
-  validate(father, mother);
-
-  Chromosome son(father);
-  Chromosome daughter(father);
-  
-  Allele left = _generate.unsigned_int(0, father.size());
-  Allele right = _generate.unsigned_int(left+1, father.size()+1);
-      
-  for(Allele index=0 ; index<father.size() ; ++index) {
-    if (left <= index and index < right) {
-      son[index] = mother[index];
-      daughter[index] = father[index];
-      
-    } else {
-      son[index] = father[index];
-      daughter[index] = mother[index];
-    }
-
-  }
-
-  children.push_back(son);
-  children.push_back(daughter);
+  validate_parents(father, mother);
+
+  // Children are built in place, straight by the crossover operator
+  children.emplace_back(father.size());
+  children.emplace_back(father.size());
+  Chromosome& daughter = children.back();
+  Chromosome& son = children[children.size() - 2];
+  _cross(father.data(), mother.data(), son.data(), daughter.data(), father.size());
 }
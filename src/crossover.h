@@ -21,6 +21,9 @@
 #define XCSF_CROSSOVER_H
 
 
+#include <algorithm>
+#include <utility>
+
 #include "utils.h"
 #include "chromosome.h"
 
@@ -31,6 +34,148 @@ using namespace std;
 namespace xcsf
 {
 
+  /** Throws unless both parents are non-empty and of the same length */
+  void
+    validate_parents(const Chromosome& father, const Chromosome& mother);
+
+
+  /*
+   * Crossover operators without virtual dispatch. Each writes both
+   * children into buffers that the caller provides, given the parents
+   * and the length of their genomes. Loops templated on the operator,
+   * such as breed_pairs, thus inline the whole crossover.
+   */
+
+  /** Swaps the tails of the parents, from a random cut point on */
+  class OnePointOperator
+  {
+  public:
+    explicit OnePointOperator(const Randomizer& randomizer) : _generate(randomizer) {}
+
+    void operator () (const Allele* father, const Allele* mother,
+		      Allele* son, Allele* daughter, unsigned int length) const
+    {
+      const Locus cut = _generate.index(length);
+      exchange(father, mother, son, daughter, length, cut, length);
+    }
+
+    static void exchange(const Allele* father, const Allele* mother,
+			 Allele* son, Allele* daughter, unsigned int length,
+			 Locus left, Locus right)
+    {
+      std::copy(father, father + left, son);
+      std::copy(mother + left, mother + right, son + left);
+      std::copy(father + right, father + length, son + right);
+      std::copy(mother, mother + left, daughter);
+      std::copy(father + left, father + right, daughter + left);
+      std::copy(mother + right, mother + length, daughter + right);
+    }
+
+  private:
+    const Randomizer& _generate;
+
+  };
+
+
+  /** Swaps the segment of the parents between two random cut points */
+  class TwoPointOperator
+  {
+  public:
+    explicit TwoPointOperator(const Randomizer& randomizer) : _generate(randomizer) {}
+
+    void operator () (const Allele* father, const Allele* mother,
+		      Allele* son, Allele* daughter, unsigned int length) const
+    {
+      const Locus left = _generate.index(length);
+      const Locus right = left + 1 + _generate.index(length - left);
+      OnePointOperator::exchange(father, mother, son, daughter, length, left, right);
+    }
+
+  private:
+    const Randomizer& _generate;
+
+  };
+
+
+  /** Swaps each allele independently, drawing 32 loci per uniform draw */
+  class UniformOperator
+  {
+  public:
+    explicit UniformOperator(const Randomizer& randomizer) : _generate(randomizer) {}
+
+    void operator () (const Allele* father, const Allele* mother,
+		      Allele* son, Allele* daughter, unsigned int length) const
+    {
+      for (Locus block=0 ; block<length ; block += 32) {
+	const std::uint32_t mask = static_cast<std::uint32_t>(_generate.uniform() * 4294967295.0);
+	const Locus end = block + 32 < length ? block + 32 : length;
+	// Branch-free blend, which the compiler turns into vector code
+	for (Locus locus=block ; locus<end ; ++locus) {
+	  const Allele swapped = static_cast<Allele>(-static_cast<int>((mask >> (locus - block)) & 1));
+	  son[locus] = (father[locus] & ~swapped) | (mother[locus] & swapped);
+	  daughter[locus] = (mother[locus] & ~swapped) | (father[locus] & swapped);
+	}
+      }
+    }
+
+  private:
+    const Randomizer& _generate;
+
+  };
+
+
+  /**
+   * Two-point crossover whose cut points fall between genes, that is
+   * between intervals or conclusions, so that it never splits the
+   * lower and upper bounds of an interval
+   */
+  class IntervalOperator
+  {
+  public:
+    IntervalOperator(const Randomizer& randomizer, unsigned int input_count)
+      : _generate(randomizer)
+      , _input_count(input_count)
+    {}
+
+    void operator () (const Allele* father, const Allele* mother,
+		      Allele* son, Allele* daughter, unsigned int length) const
+    {
+      const unsigned int gene_count = length - _input_count;
+      const unsigned int left = _generate.index(gene_count);
+      const unsigned int right = left + 1 + _generate.index(gene_count - left);
+      OnePointOperator::exchange(father, mother, son, daughter, length,
+				 start_of(left), start_of(right));
+    }
+
+  private:
+    Locus start_of(unsigned int gene) const
+    {
+      return gene < _input_count ? 2 * gene : _input_count + gene;
+    }
+
+    const Randomizer& _generate;
+    const unsigned int _input_count;
+
+  };
+
+
+  /**
+   * Crosses pair_count pairs of parents, laid out father then mother,
+   * into children laid out son then daughter, all of the same length
+   */
+  template <class Operator>
+  void
+    breed_pairs(const Operator& cross, const Allele* parents, Allele* children,
+		unsigned int pair_count, unsigned int length)
+  {
+    for (unsigned int pair=0 ; pair<pair_count ; ++pair) {
+      const Allele* father = parents + 2 * pair * length;
+      Allele* son = children + 2 * pair * length;
+      cross(father, father + length, son, son + length, length);
+    }
+  }
+
+
   class Crossover
   {
   public:
@@ -53,7 +198,43 @@ namespace xcsf
     virtual void operator () (const Chromosome& father, const Chromosome& mother, vector<Chromosome>& children) const;
 
   private:
-    const Randomizer& _generate;
+    TwoPointOperator _cross;
+
+  };
+
+
+  /**
+   * Adapts any of the crossover operators above to the Crossover
+   * interface, for the evolutions that do not batch their breeding
+   */
+  template <class Operator>
+  class StaticCrossover : public Crossover
+  {
+  public:
+    template <class... Arguments>
+    explicit StaticCrossover(Arguments&&... arguments)
+      : Crossover()
+      , _cross(std::forward<Arguments>(arguments)...)
+    {}
+
+    virtual unsigned int children_count(void) const
+    {
+      return 2;
+    }
+
+    virtual void operator () (const Chromosome& father, const Chromosome& mother, vector<Chromosome>& children) const
+    {
+      validate_parents(father, mother);
+
+      children.emplace_back(father.size());
+      children.emplace_back(father.size());
+      Chromosome& daughter = children.back();
+      Chromosome& son = children[children.size() - 2];
+      _cross(father.data(), mother.data(), son.data(), daughter.data(), father.size());
+    }
+
+  private:
+    Operator _cross;
 
   };
 
@@ -17,8 +17,11 @@
  */
 
 
+#include <algorithm>
 #include <sstream>
 #include <cassert>
+#include <cmath>
+#include <limits>
 
 
 #include "evolution.h"
@@ -37,6 +40,17 @@ Decision::~Decision()
 {}
 
 
+unsigned int
+Decision::skipped_loci(unsigned int limit) const
+{
+  unsigned int skipped = 0;
+  while (skipped < limit and not shall_mutate()) {
+    ++skipped;
+  }
+  return skipped;
+}
+
+
 RandomDecision::RandomDecision(const Randomizer& generator,
 			       double evolution_probability,
 			       double allele_mutation_probability)
@@ -44,6 +58,7 @@ RandomDecision::RandomDecision(const Randomizer& generator,
   , _generator(generator)
   , _evolution_probability(evolution_probability)
   , _allele_mutation_probability(allele_mutation_probability)
+  , _log_intact_probability(std::log1p(-std::min(allele_mutation_probability, 1.0)))
 {}
 
 
@@ -65,6 +80,54 @@ RandomDecision::shall_mutate(void) const
 }
 
 
+unsigned int
+RandomDecision::skipped_loci(unsigned int limit) const
+{
+  if (_allele_mutation_probability >= 1.) return 0;
+  if (_allele_mutation_probability <= 0.) return limit;
+
+  const double draw = _generator.uniform();
+  if (draw <= 0.) return limit;
+
+  const double skipped = std::floor(std::log(draw) / _log_intact_probability);
+  return skipped < limit ? static_cast<unsigned int>(skipped) : limit;
+}
+
+
+
+MutationEngine::MutationEngine(const Decision&		decision,
+			       const AlleleMutation&	mutation)
+  : _decision(decision)
+  , _mutate(mutation)
+{}
+
+
+void
+MutationEngine::operator () (std::vector<Chromosome>&	subjects,
+			     unsigned int		first,
+			     std::vector<Mutation>&	mutations) const
+{
+  unsigned int total = 0;
+  for (unsigned int index=first ; index<subjects.size() ; ++index) {
+    total += subjects[index].size();
+  }
+
+  unsigned int subject = first;
+  unsigned int start = 0;
+  for (unsigned int position = _decision.skipped_loci(total) ;
+       position < total ;
+       position += 1 + _decision.skipped_loci(total - position - 1)) {
+    while (position >= start + subjects[subject].size()) {
+      start += subjects[subject].size();
+      ++subject;
+    }
+    const Locus locus = position - start;
+    _mutate(subjects[subject], locus);
+    mutations.push_back(Mutation(subject, locus));
+  }
+}
+
+
 
 EvolutionListener::~EvolutionListener(void)
 {};
@@ -91,7 +154,7 @@ NoListener::on_breeding(const MetaRule& father, const MetaRule& mother) const
 
 
 void
-NoListener::on_mutation(const Chromosome& subject, const Allele& locus) const
+NoListener::on_mutation(const Chromosome& subject, const Locus& locus) const
 {}
 
 
@@ -128,7 +191,7 @@ LogListener::on_breeding(const MetaRule& father, const MetaRule& mother) const
 
 
 void
-LogListener::on_mutation(const Chromosome& subject, const Allele& locus) const
+LogListener::on_mutation(const Chromosome& subject, const Locus& locus) const
 {
   _out << "Mutation of " << subject << " at " << locus << endl;
 }
@@ -139,12 +202,23 @@ Evolution::~Evolution()
 {}
 
 
+void
+Evolution::evolve_niche(RuleSet& rules, SlotSpan action_set) const
+{}
+
+
+void
+Evolution::make_room(RuleSet& rules, unsigned int count) const
+{}
+
+
 
 DefaultEvolution::DefaultEvolution(MetaRulePool&		rules,
 				   const Codec&			codec,
 				   const Decision&		decision,
 				   const Crossover&		crossover,
 				   const Selection&		selection,
+				   const Deletion&		deletion,
 				   const AlleleMutation&	mutation,
 				   const EvolutionListener&	listener)
   : _rules(rules)
@@ -152,8 +226,15 @@ DefaultEvolution::DefaultEvolution(MetaRulePool&		rules,
   , _decision(decision)
   , _crossover(crossover)
   , _select_parents(selection)
+  , _delete(deletion)
   , _mutate(mutation)
   , _listener(listener)
+  , _subsumption(nullptr)
+  , _mutations(decision, mutation)
+  , _mutated()
+  , _father()
+  , _mother()
+  , _offspring()
 {}
 
 
@@ -168,19 +249,66 @@ DefaultEvolution::evolve(RuleSet& rules) const
 
   assert (not rules.is_empty() && "Impossible evolution, no rules");
 
-  auto deleted_rules = rules.enforce_capacity(_crossover.children_count(),
-					       Comparators::with_lower_weighted_payoff);
-  for(auto each : deleted_rules) {
-    _listener.on_rule_deleted(*each);
-  }
+  make_room(rules, _crossover.children_count());
 
   auto parents = _select_parents(rules);
 
   auto children = breed(*parents[0], *parents[1]);
   for (auto each_child: children) {
-    rules.add(*each_child);
+    insert(rules, *each_child);
+  }
+
+}
+
+
+void
+DefaultEvolution::evolve_niche(RuleSet& rules, SlotSpan action_set) const
+{
+  if (_subsumption == nullptr) return;
+
+  (*_subsumption)(rules, action_set);
+}
+
+
+void
+DefaultEvolution::make_room(RuleSet& rules, unsigned int count) const
+{
+  if (rules.remaining_capacity() >= count) return;
+
+  auto deleted_rules = _delete(rules, count - rules.remaining_capacity());
+  for(auto each : deleted_rules) {
+    _listener.on_rule_deleted(*each);
+    _rules.release(each);
   }
+}
+
 
+void
+DefaultEvolution::subsume_with(const Subsumption* subsumption)
+{
+  _subsumption = subsumption;
+}
+
+
+void
+DefaultEvolution::insert(RuleSet& rules, MetaRule& child) const
+{
+  MetaRule* subsumer = nullptr;
+  if (_subsumption != nullptr) {
+    subsumer = _subsumption->subsumer(rules, child);
+  }
+
+  if (subsumer != nullptr) {
+    _rules.set_numerosity(subsumer->slot(), subsumer->numerosity() + child.numerosity());
+    _rules.release(&child);
+    return;
+  }
+
+  if (rules.is_full() and rules.twin(child) == nullptr) {
+    _rules.release(&child);
+    return;
+  }
+  rules.merge(child);
 }
 
 
@@ -238,10 +366,10 @@ DefaultEvolution::make_rule(std::vector<Interval>	constraints,
 vector<MetaRule*>
 DefaultEvolution::breed(const MetaRule& father, const MetaRule& mother) const
 {
-  vector<Chromosome> children;
-  _crossover(_codec.encode(father),
-	     _codec.encode(mother),
-	     children);
+  _codec.encode(father, _father);
+  _codec.encode(mother, _mother);
+  _offspring.clear();
+  _crossover(_father, _mother, _offspring);
 
   _listener.on_breeding(father, mother);
 
@@ -250,9 +378,10 @@ DefaultEvolution::breed(const MetaRule& father, const MetaRule& mother) const
 		  (father.payoff() + mother.payoff()) / 2,
 		  (father.error() + mother.error()) / 2);
 
+  mutate(_offspring);
+
   vector<MetaRule*> children_rules;
-  for (auto each_child: children) {
-      mutate(each_child);
+  for (auto& each_child: _offspring) {
       MetaRule *rule = _codec.decode(father.dimensions(), each_child, performance);
       children_rules.push_back(rule);
       _listener.on_rule_added(*rule);
@@ -263,12 +392,567 @@ DefaultEvolution::breed(const MetaRule& father, const MetaRule& mother) const
 
 
 void
-DefaultEvolution::mutate(Chromosome& child) const
+DefaultEvolution::mutate(vector<Chromosome>& children) const
 {
-  for(Allele each_locus=0 ; each_locus<child.size() ; ++each_locus) {
-    if (_decision.shall_mutate()) {
-      _mutate(child, each_locus);
-      _listener.on_mutation(child, each_locus);
+  _mutated.clear();
+  _mutations(children, 0, _mutated);
+  for (auto each_mutation: _mutated) {
+    _listener.on_mutation(children[each_mutation.first], each_mutation.second);
+  }
+}
+
+
+
+const unsigned int NicheEvolution::DEFAULT_THRESHOLD;
+
+
+NicheEvolution::NicheEvolution(MetaRulePool&		rules,
+			       const Codec&		codec,
+			       const Decision&		decisions,
+			       const Crossover&		crossover,
+			       const Selection&		selection,
+			       const Deletion&		deletion,
+			       const AlleleMutation&	mutation,
+			       const EvolutionListener&	listener,
+			       unsigned int		threshold)
+  : DefaultEvolution(rules, codec, decisions, crossover, selection, deletion, mutation, listener)
+  , _threshold(threshold)
+  , _niche(rules.dimensions(), std::numeric_limits<unsigned int>::max())
+{}
+
+
+NicheEvolution::~NicheEvolution()
+{}
+
+
+void
+NicheEvolution::evolve(RuleSet& rules) const
+{}
+
+
+void
+NicheEvolution::evolve_niche(RuleSet& rules, SlotSpan action_set) const
+{
+  DefaultEvolution::evolve_niche(rules, action_set);
+
+  _rules.tick();
+  _niche.clear();
+  for (auto each_slot: action_set) {
+    MetaRule& each_rule = _rules.rule(each_slot);
+    if (rules.contains(each_rule)) _niche.add(each_rule);
+  }
+  if (_niche.size() < 2 or not is_due(_niche.slots())) return;
+
+  for (auto each_slot: _niche.slots()) {
+    _rules.stamp(each_slot);
+  }
+
+  auto parents = _select_parents(_niche);
+  auto children = breed(*parents[0], *parents[1]);
+
+  if (rules.remaining_capacity() < children.size()) {
+    auto deleted_rules = _delete(_niche, children.size() - rules.remaining_capacity());
+    for (auto each: deleted_rules) {
+      rules.remove(*each);
+      _listener.on_rule_deleted(*each);
+      _rules.release(each);
+    }
+  }
+
+  for (auto each_child: children) {
+    insert(rules, *each_child);
+  }
+}
+
+
+bool
+NicheEvolution::is_due(SlotSpan action_set) const
+{
+  unsigned long total_age = 0;
+  for (auto each_slot: action_set) {
+    total_age += _rules.now() - _rules.timestamp(each_slot);
+  }
+  return total_age > static_cast<unsigned long>(_threshold) * action_set.size();
+}
+
+
+
+Breeder::Breeder(const Decision&		decision,
+		 const Crossover&		crossover,
+		 const AlleleMutation&		mutation)
+  : _decision(&decision)
+  , _crossover(&crossover)
+  , _mutation(&mutation)
+{}
+
+
+const Decision&
+Breeder::decision(void) const
+{
+  return *_decision;
+}
+
+
+const Crossover&
+Breeder::crossover(void) const
+{
+  return *_crossover;
+}
+
+
+const AlleleMutation&
+Breeder::mutation(void) const
+{
+  return *_mutation;
+}
+
+
+
+const unsigned int BatchEvolution::DEFAULT_BATCH_SIZE;
+
+
+BatchEvolution::BatchEvolution(MetaRulePool&			rules,
+			       const Codec&			codec,
+			       const Decision&			decision,
+			       const Selection&			selection,
+			       const Deletion&			deletion,
+			       const std::vector<Breeder>&	breeders,
+			       const EvolutionListener&		listener,
+			       unsigned int			batch_size)
+  : DefaultEvolution(rules,
+		     codec,
+		     decision,
+		     first(breeders).crossover(),
+		     selection,
+		     deletion,
+		     first(breeders).mutation(),
+		     listener)
+  , _breeders(breeders)
+  , _batch_size(batch_size)
+  , _chromosomes()
+  , _performances()
+  , _children(breeders.size())
+  , _children_pairs(breeders.size())
+  , _mutations(breeders.size())
+  , _lock()
+  , _changed()
+  , _round(0)
+  , _running(0)
+  , _stopping(false)
+  , _workers()
+{
+  if (_batch_size == 0) {
+    throw std::invalid_argument("Batch evolution requires at least one pair of parents per batch.");
+  }
+
+  const unsigned int share = (_batch_size + _breeders.size() - 1) / _breeders.size();
+  for (unsigned int worker=0 ; worker<_breeders.size() ; ++worker) {
+    _children[worker].reserve(share * _breeders[worker].crossover().children_count());
+    _children_pairs[worker].reserve(share * _breeders[worker].crossover().children_count());
+  }
+  _chromosomes.resize(2 * _batch_size);
+  _performances.reserve(_batch_size);
+
+  for (unsigned int worker=1 ; worker<_breeders.size() ; ++worker) {
+    _workers.emplace_back(&BatchEvolution::run, this, worker);
+  }
+}
+
+
+BatchEvolution::~BatchEvolution()
+{
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _stopping = true;
+  }
+  _changed.notify_all();
+  for (auto& each_worker: _workers) {
+    each_worker.join();
+  }
+}
+
+
+const Breeder&
+BatchEvolution::first(const std::vector<Breeder>& breeders)
+{
+  if (breeders.empty()) {
+    throw std::invalid_argument("Batch evolution requires at least one breeder.");
+  }
+  return breeders.front();
+}
+
+
+void
+BatchEvolution::evolve(RuleSet& rules) const
+{
+  if (not _decision.shall_evolve()) return;
+
+  assert (not rules.is_empty() && "Impossible evolution, no rules");
+
+  const unsigned int children_count = _batch_size * _crossover.children_count();
+  if (rules.remaining_capacity() < children_count) {
+    const unsigned int excess = std::min<unsigned int>(children_count - rules.remaining_capacity(),
+						       rules.size() - 1);
+    for (auto each: _delete(rules, excess)) {
+      _listener.on_rule_deleted(*each);
+      _rules.release(each);
+    }
+  }
+
+  _performances.clear();
+  for (unsigned int pair=0 ; pair<_batch_size ; ++pair) {
+    auto parents = _select_parents(rules);
+    const MetaRule& father = *parents[0];
+    const MetaRule& mother = *parents[1];
+    _listener.on_breeding(father, mother);
+
+    _codec.encode(father, _chromosomes[2 * pair]);
+    _codec.encode(mother, _chromosomes[2 * pair + 1]);
+    _performances.push_back(Performance((father.fitness() + mother.fitness()) / 2,
+					(father.payoff() + mother.payoff()) / 2,
+					(father.error() + mother.error()) / 2));
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    ++_round;
+    _running = _workers.size();
+  }
+  _changed.notify_all();
+  breed_share(0);
+  {
+    std::unique_lock<std::mutex> guard(_lock);
+    _changed.wait(guard, [this] { return _running == 0; });
+  }
+
+  for (unsigned int worker=0 ; worker<_breeders.size() ; ++worker) {
+    const std::vector<Chromosome>& children = _children[worker];
+    for (auto each_mutation: _mutations[worker]) {
+      _listener.on_mutation(children[each_mutation.first], each_mutation.second);
+    }
+    for (unsigned int index=0 ; index<children.size() ; ++index) {
+      MetaRule* child = _codec.decode(rules.dimensions(),
+				      children[index],
+				      _performances[_children_pairs[worker][index]]);
+      _listener.on_rule_added(*child);
+      insert(rules, *child);
+    }
+  }
+}
+
+
+void
+BatchEvolution::breed_share(unsigned int worker) const
+{
+  const Breeder& breeder = _breeders[worker];
+  std::vector<Chromosome>& children = _children[worker];
+  std::vector<unsigned int>& children_pairs = _children_pairs[worker];
+  std::vector<Mutation>& mutations = _mutations[worker];
+  children.clear();
+  children_pairs.clear();
+  mutations.clear();
+
+  for (unsigned int pair=worker ; pair<_batch_size ; pair += _breeders.size()) {
+    breeder.crossover()(_chromosomes[2 * pair], _chromosomes[2 * pair + 1], children);
+    children_pairs.resize(children.size(), pair);
+  }
+
+  MutationEngine mutate(breeder.decision(), breeder.mutation());
+  mutate(children, 0, mutations);
+}
+
+
+void
+BatchEvolution::run(unsigned int worker)
+{
+  unsigned long done = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard(_lock);
+      _changed.wait(guard, [this, done] { return _stopping or _round != done; });
+      if (_stopping) return;
+      done = _round;
+    }
+
+    breed_share(worker);
+
+    {
+      std::lock_guard<std::mutex> guard(_lock);
+      --_running;
+    }
+    _changed.notify_all();
+  }
+}
+
+
+
+BackgroundEvolution::BackgroundEvolution(MetaRulePool&		rules,
+					 const Decision&	decision,
+					 const Deletion&	deletion,
+					 const Evolution&	worker_evolution,
+					 MetaRulePool&		worker_rules)
+  : _rules(rules)
+  , _codec(rules)
+  , _decision(decision)
+  , _delete(deletion)
+  , _worker_evolution(worker_evolution)
+  , _worker_rules(worker_rules)
+  , _worker_codec(worker_rules)
+  , _subsumption(nullptr)
+  , _lock()
+  , _changed()
+  , _state(State::IDLE)
+  , _stopping(false)
+  , _owner(nullptr)
+  , _handles()
+  , _chromosomes()
+  , _performances()
+  , _numerosities()
+  , _capacity(0)
+  , _deleted()
+  , _grown()
+  , _growths()
+  , _children()
+  , _children_performances()
+  , _children_numerosities()
+  , _worker(&BackgroundEvolution::run, this)
+{
+  if (_rules.dimensions() != _worker_rules.dimensions()) {
+    stringstream message;
+    message << "Background evolution requires pools of the same dimensions, but got "
+	    << _rules.dimensions() << " and " << _worker_rules.dimensions() << ".";
+    {
+      std::lock_guard<std::mutex> guard(_lock);
+      _stopping = true;
+    }
+    _changed.notify_all();
+    _worker.join();
+    throw std::invalid_argument(message.str());
+  }
+}
+
+
+BackgroundEvolution::~BackgroundEvolution()
+{
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _stopping = true;
+  }
+  _changed.notify_all();
+  _worker.join();
+}
+
+
+void
+BackgroundEvolution::initialise(RuleSet& rules) const
+{
+  std::unique_lock<std::mutex> guard(_lock);
+  _changed.wait(guard, [this] { return _state != State::PENDING; });
+
+  RuleSet seeds(rules.dimensions(), rules.capacity());
+  _worker_evolution.initialise(seeds);
+  for (unsigned int index=0 ; index<seeds.size() ; ++index) {
+    MetaRule& each_seed = seeds[index];
+    if (not rules.is_full()) {
+      rules.add(*_codec.decode(rules.dimensions(),
+			       _worker_codec.encode(each_seed),
+			       each_seed.performance()));
+    }
+    _worker_rules.release(&each_seed);
+  }
+}
+
+
+void
+BackgroundEvolution::evolve(RuleSet& rules) const
+{
+  std::unique_lock<std::mutex> guard(_lock, std::try_to_lock);
+  if (guard.owns_lock()) {
+    if (_state == State::DONE and _owner == &rules) {
+      apply_proposal(rules);
+      _state = State::IDLE;
+    }
+
+    if (_state == State::IDLE
+	and not rules.is_empty()
+	and _decision.shall_evolve()) {
+      take_snapshot(rules);
+      _state = State::PENDING;
+      _changed.notify_all();
+    }
+    guard.unlock();
+  }
+}
+
+
+void
+BackgroundEvolution::evolve_niche(RuleSet& rules, SlotSpan action_set) const
+{
+  if (_subsumption == nullptr) return;
+
+  (*_subsumption)(rules, action_set);
+}
+
+
+void
+BackgroundEvolution::make_room(RuleSet& rules, unsigned int count) const
+{
+  if (rules.remaining_capacity() >= count) return;
+
+  for (auto each: _delete(rules, count - rules.remaining_capacity())) {
+    _rules.release(each);
+  }
+}
+
+
+void
+BackgroundEvolution::subsume_with(const Subsumption* subsumption)
+{
+  _subsumption = subsumption;
+}
+
+
+void
+BackgroundEvolution::synchronise(void) const
+{
+  std::unique_lock<std::mutex> guard(_lock);
+  _changed.wait(guard, [this] { return _state != State::PENDING; });
+}
+
+
+void
+BackgroundEvolution::take_snapshot(const RuleSet& rules) const
+{
+  _owner = &rules;
+  _capacity = rules.capacity();
+  _handles.clear();
+  _performances.clear();
+  _numerosities.clear();
+  _chromosomes.resize(rules.size());
+  for (unsigned int index=0 ; index<rules.size() ; ++index) {
+    _handles.push_back(_rules.handle(rules.slot(index)));
+    _codec.encode(rules[index], _chromosomes[index]);
+    _performances.push_back(rules[index].performance());
+    _numerosities.push_back(rules[index].numerosity());
+  }
+}
+
+
+void
+BackgroundEvolution::apply_proposal(RuleSet& rules) const
+{
+  for (auto each_handle: _deleted) {
+    if (not _rules.is_current(each_handle)) continue;
+
+    MetaRule& rule = _rules.rule(each_handle.slot);
+    if (rules.remove(rule)) {
+      _rules.release(&rule);
+    }
+  }
+
+  // Children the worker merged into an original only show as the
+  // numerosity that original gained
+  for (unsigned int index=0 ; index<_grown.size() ; ++index) {
+    if (not _rules.is_current(_grown[index])) continue;
+
+    const unsigned int slot = _grown[index].slot;
+    if (rules.contains(_rules.rule(slot))) {
+      _rules.set_numerosity(slot, _rules.numerosity(slot) + _growths[index]);
+    }
+  }
+
+  for (unsigned int index=0 ; index<_children_performances.size() ; ++index) {
+    MetaRule* child = _codec.decode(rules.dimensions(),
+				    _children[index],
+				    _children_performances[index]);
+    _rules.set_numerosity(child->slot(), _children_numerosities[index]);
+    MetaRule* subsumer = nullptr;
+    if (_subsumption != nullptr) {
+      subsumer = _subsumption->subsumer(rules, *child);
+    }
+    if (subsumer != nullptr) {
+      _rules.set_numerosity(subsumer->slot(), subsumer->numerosity() + child->numerosity());
+      _rules.release(child);
+      continue;
+    }
+    if (rules.twin(*child) == nullptr) {
+      make_room(rules, 1);
+      if (rules.is_full()) {
+	_rules.release(child);
+	continue;
+      }
+    }
+    rules.merge(*child);
+  }
+}
+
+
+void
+BackgroundEvolution::run(void)
+{
+  std::unique_lock<std::mutex> guard(_lock);
+  while (true) {
+    _changed.wait(guard, [this] { return _stopping or _state == State::PENDING; });
+    if (_stopping) return;
+
+    // The request side only reads the snapshot when the state is
+    // IDLE, so it is safe to evolve it without holding the lock
+    guard.unlock();
+    evolve_snapshot();
+    guard.lock();
+
+    _state = State::DONE;
+    _changed.notify_all();
+  }
+}
+
+
+void
+BackgroundEvolution::evolve_snapshot(void)
+{
+  RuleSet copy(_worker_rules.dimensions(), _capacity);
+  vector<RuleHandle> originals;
+  for (unsigned int index=0 ; index<_chromosomes.size() ; ++index) {
+    MetaRule* rule = _worker_codec.decode(_worker_rules.dimensions(),
+					  _chromosomes[index],
+					  _performances[index]);
+    _worker_rules.set_numerosity(rule->slot(), _numerosities[index]);
+    originals.push_back(_worker_rules.handle(rule->slot()));
+    copy.add(*rule);
+  }
+
+  _worker_evolution.evolve(copy);
+
+  _deleted.clear();
+  _grown.clear();
+  _growths.clear();
+  vector<bool> is_original(_worker_rules.slot_count(), false);
+  for (unsigned int index=0 ; index<originals.size() ; ++index) {
+    if (not _worker_rules.is_current(originals[index])) {
+      _deleted.push_back(_handles[index]);
+      continue;
+    }
+    const unsigned int slot = originals[index].slot;
+    is_original[slot] = true;
+    if (_worker_rules.numerosity(slot) > _numerosities[index]) {
+      _grown.push_back(_handles[index]);
+      _growths.push_back(_worker_rules.numerosity(slot) - _numerosities[index]);
+    }
+  }
+
+  // Chromosomes are reused across rounds, so _children may hold more
+  // than this round brought: the performances tell how many are new
+  _children_performances.clear();
+  _children_numerosities.clear();
+  for (unsigned int index=0 ; index<copy.size() ; ++index) {
+    MetaRule& each_rule = copy[index];
+    if (not is_original[each_rule.slot()]) {
+      const unsigned int count = _children_performances.size();
+      if (count == _children.size()) _children.resize(count + 1);
+      _worker_codec.encode(each_rule, _children[count]);
+      _children_performances.push_back(each_rule.performance());
+      _children_numerosities.push_back(each_rule.numerosity());
     }
+    _worker_rules.release(&each_rule);
   }
 }
@@ -21,12 +21,17 @@
 
 
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "utils.h"
 #include "rule.h"
+#include "chromosome.h"
 #include "selection.h"
 #include "crossover.h"
 #include "mutation.h"
+#include "subsumption.h"
 
 
 namespace xcsf {
@@ -41,6 +46,9 @@ namespace xcsf {
     virtual bool shall_evolve(void) const = 0;
     virtual bool shall_mutate(void) const = 0;
 
+    /** Count of loci to leave intact before the next mutation, at most limit */
+    virtual unsigned int skipped_loci(unsigned int limit) const;
+
   };
 
 
@@ -57,10 +65,41 @@ namespace xcsf {
 
     virtual bool shall_mutate(void) const;
 
+    /** Draws the gap from a geometric distribution, at once */
+    virtual unsigned int skipped_loci(unsigned int limit) const;
+
   private:
     const Randomizer&	_generator;
     const double	_evolution_probability;
     const double	_allele_mutation_probability;
+    const double	_log_intact_probability;
+
+  };
+
+
+  typedef std::pair<unsigned int, Locus> Mutation;
+
+
+  /**
+   * Mutates the loci that a decision picks, jumping from one mutated
+   * locus to the next, across chromosomes, so that the cost depends
+   * on the number of mutations rather than on the number of alleles
+   */
+  class MutationEngine
+  {
+  public:
+    MutationEngine(const Decision& decision, const AlleleMutation& mutation);
+
+    /** Mutates the subjects from the first on, recording the mutations */
+    void
+      operator () (std::vector<Chromosome>&	subjects,
+		   unsigned int			first,
+		   std::vector<Mutation>&	mutations)
+      const;
+
+  private:
+    const Decision&		_decision;
+    const AlleleMutation&	_mutate;
 
   };
 
@@ -85,7 +124,7 @@ namespace xcsf {
 
     virtual void
       on_mutation(const Chromosome&	chromosome,
-		  const Allele&	locus)
+		  const Locus&	locus)
       const = 0;
   };
 
@@ -109,7 +148,7 @@ namespace xcsf {
       const;
 
     virtual void
-      on_mutation(const Chromosome& chromosome, const Allele& locus)
+      on_mutation(const Chromosome& chromosome, const Locus& locus)
       const;
   };
 
@@ -135,7 +174,7 @@ namespace xcsf {
       const;
 
     virtual void
-      on_mutation(const Chromosome& chromosome, const Allele& locus)
+      on_mutation(const Chromosome& chromosome, const Locus& locus)
       const;
 
   private:
@@ -162,6 +201,16 @@ namespace xcsf {
       evolve(RuleSet& rules)
       const = 0;
 
+    /** Evolution within the action set just rewarded, none by default */
+    virtual void
+      evolve_niche(RuleSet& rules, SlotSpan action_set)
+      const;
+
+    /** Frees slots until count rules fit, none by default */
+    virtual void
+      make_room(RuleSet& rules, unsigned int count)
+      const;
+
   };
 
 
@@ -177,6 +226,7 @@ namespace xcsf {
 		     const Decision&		decisions,
 		     const Crossover&		crossover,
 		     const Selection&		selection,
+		     const Deletion&		deletion,
 		     const AlleleMutation&	mutation,
 		     const EvolutionListener&	listener);
 
@@ -190,16 +240,35 @@ namespace xcsf {
       evolve(RuleSet& rules)
       const;
 
+    /** Subsumption within the action set just rewarded, if any */
+    virtual void
+      evolve_niche(RuleSet& rules, SlotSpan action_set)
+      const;
 
-  private:
+    /** Deletes rules, as the deletion picks them */
+    virtual void
+      make_room(RuleSet& rules, unsigned int count)
+      const;
+
+    /** Subsumes children and action sets, none by default */
+    void
+      subsume_with(const Subsumption* subsumption);
+
+
+  protected:
     std::vector<MetaRule*>
       breed(const MetaRule& father, const MetaRule& mother)
       const;
 
     void
-      mutate(Chromosome& child)
+      insert(RuleSet& rules, MetaRule& child)
       const;
 
+    void
+      mutate(std::vector<Chromosome>& children)
+      const;
+
+  private:
     void
       create_rule(RuleSet&	rules,
 		  const Vector& seed,
@@ -210,13 +279,246 @@ namespace xcsf {
     MetaRule*
       make_rule(std::vector<Interval>, std::vector<unsigned int>) const;
 
+  protected:
     MetaRulePool&		_rules;
     const Codec&		_codec;
     const Decision&		_decision;
     const Crossover&		_crossover;
     const Selection&		_select_parents;
+    const Deletion&		_delete;
     const AlleleMutation&	_mutate;
     const EvolutionListener&	_listener;
+    const Subsumption*		_subsumption;
+    const MutationEngine	_mutations;
+    mutable std::vector<Mutation>	_mutated;
+    mutable Chromosome			_father;
+    mutable Chromosome			_mother;
+    mutable std::vector<Chromosome>	_offspring;
+  };
+
+
+  /**
+   * Niche genetic algorithm, which breeds within the action set once
+   * its rules have, on average, not been evolved for more than a
+   * given number of steps. Offspring replace rules of the action set
+   * when the rule set is full, so that the cost of each step depends
+   * on the size of the action set only.
+   */
+  class NicheEvolution
+    : public DefaultEvolution
+  {
+  public:
+    static const unsigned int DEFAULT_THRESHOLD = 25;
+
+    NicheEvolution(MetaRulePool&		rules,
+		   const Codec&			codec,
+		   const Decision&		decisions,
+		   const Crossover&		crossover,
+		   const Selection&		selection,
+		   const Deletion&		deletion,
+		   const AlleleMutation&	mutation,
+		   const EvolutionListener&	listener,
+		   unsigned int			threshold = DEFAULT_THRESHOLD);
+
+    virtual ~NicheEvolution();
+
+    virtual void
+      evolve(RuleSet& rules)
+      const;
+
+    virtual void
+      evolve_niche(RuleSet& rules, SlotSpan action_set)
+      const;
+
+  private:
+    bool
+      is_due(SlotSpan action_set)
+      const;
+
+    const unsigned int	_threshold;
+    mutable RuleSet	_niche;
+  };
+
+
+  /**
+   * Operators that a single breeding thread uses. They must not share
+   * a randomizer with those of other breeders.
+   */
+  class Breeder
+  {
+  public:
+    Breeder(const Decision&		decision,
+	    const Crossover&		crossover,
+	    const AlleleMutation&	mutation);
+
+    const Decision&		decision(void) const;
+    const Crossover&		crossover(void) const;
+    const AlleleMutation&	mutation(void) const;
+
+  private:
+    const Decision*		_decision;
+    const Crossover*		_crossover;
+    const AlleleMutation*	_mutation;
+
+  };
+
+
+  /**
+   * Evolution breeding a batch of parent pairs at once. Parents are
+   * selected and encoded up front, then the calling thread and one
+   * thread per extra breeder share out the crossovers and mutations,
+   * each filling buffers of its own. The children are then decoded
+   * and merged into the rule set in a single step, once the deletion
+   * made room for the whole batch.
+   */
+  class BatchEvolution
+    : public DefaultEvolution
+  {
+  public:
+    static const unsigned int DEFAULT_BATCH_SIZE = 8;
+
+    BatchEvolution(MetaRulePool&			rules,
+		   const Codec&				codec,
+		   const Decision&			decision,
+		   const Selection&			selection,
+		   const Deletion&			deletion,
+		   const std::vector<Breeder>&		breeders,
+		   const EvolutionListener&		listener,
+		   unsigned int				batch_size = DEFAULT_BATCH_SIZE);
+
+    virtual ~BatchEvolution();
+
+    virtual void
+      evolve(RuleSet& rules)
+      const;
+
+  private:
+    static const Breeder&
+      first(const std::vector<Breeder>& breeders);
+
+    void
+      breed_share(unsigned int worker)
+      const;
+
+    void
+      run(unsigned int worker);
+
+    const std::vector<Breeder>			_breeders;
+    const unsigned int				_batch_size;
+
+    mutable std::vector<Chromosome>		_chromosomes;
+    mutable std::vector<Performance>		_performances;
+
+    mutable std::vector<std::vector<Chromosome>>	_children;
+    mutable std::vector<std::vector<unsigned int>>	_children_pairs;
+    mutable std::vector<std::vector<Mutation>>	_mutations;
+
+    mutable std::mutex				_lock;
+    mutable std::condition_variable		_changed;
+    mutable unsigned long			_round;
+    mutable unsigned int			_running;
+    bool					_stopping;
+
+    std::vector<std::thread>			_workers;
+  };
+
+
+  /**
+   * Evolution running on a worker thread, so that predictions never
+   * wait for the genetic algorithm. When the decision fires and the
+   * worker is idle, the request copies the rules into a snapshot,
+   * which the worker evolves in a pool of its own. The resulting
+   * proposal, that is the rules to delete and the children to add, is
+   * applied by the next request that finds it ready. Deletions of
+   * rules that meanwhile went stale are ignored. As the worker may lag
+   * behind, children and covering that find the rule set full make
+   * room through the deletion, on the requesting thread.
+   */
+  class BackgroundEvolution
+    : public Evolution
+  {
+  public:
+    BackgroundEvolution(MetaRulePool&		rules,
+			const Decision&		decision,
+			const Deletion&		deletion,
+			const Evolution&	worker_evolution,
+			MetaRulePool&		worker_rules);
+
+    virtual ~BackgroundEvolution();
+
+    virtual void
+      initialise(RuleSet& rule_set)
+      const;
+
+    virtual void
+      evolve(RuleSet& rules)
+      const;
+
+    /** Subsumption within the action set just rewarded, if any */
+    virtual void
+      evolve_niche(RuleSet& rules, SlotSpan action_set)
+      const;
+
+    /** Deletes rules, as the deletion picks them */
+    virtual void
+      make_room(RuleSet& rules, unsigned int count)
+      const;
+
+    /** Subsumes children and action sets, none by default */
+    void
+      subsume_with(const Subsumption* subsumption);
+
+    /** Blocks until the pending evolution, if any, is ready */
+    void
+      synchronise(void)
+      const;
+
+  private:
+    enum class State { IDLE, PENDING, DONE };
+
+    void
+      take_snapshot(const RuleSet& rules)
+      const;
+
+    void
+      apply_proposal(RuleSet& rules)
+      const;
+
+    void
+      run(void);
+
+    void
+      evolve_snapshot(void);
+
+    MetaRulePool&		_rules;
+    const Codec			_codec;
+    const Decision&		_decision;
+    const Deletion&		_delete;
+    const Evolution&		_worker_evolution;
+    MetaRulePool&		_worker_rules;
+    const Codec			_worker_codec;
+    const Subsumption*		_subsumption;
+
+    mutable std::mutex			_lock;
+    mutable std::condition_variable	_changed;
+    mutable State			_state;
+    bool				_stopping;
+
+    mutable const RuleSet*		_owner;
+    mutable std::vector<RuleHandle>	_handles;
+    mutable std::vector<Chromosome>	_chromosomes;
+    mutable std::vector<Performance>	_performances;
+    mutable std::vector<unsigned int>	_numerosities;
+    mutable unsigned int		_capacity;
+
+    std::vector<RuleHandle>		_deleted;
+    std::vector<RuleHandle>		_grown;
+    std::vector<unsigned int>		_growths;
+    std::vector<Chromosome>		_children;
+    std::vector<Performance>		_children_performances;
+    std::vector<unsigned int>		_children_numerosities;
+
+    std::thread				_worker;
   };
 
 
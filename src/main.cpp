@@ -16,6 +16,7 @@
  *
  */
 
+#include <deque>
 #include <fstream>
 
 #include "application.h"
@@ -28,41 +29,89 @@ using namespace xcsf;
 int
 main(int argc, char** argv)
 {
-  cout << APPLICATION << " v" << VERSION << endl;
+  // With "--binary", requests and replies are binary frames, which
+  // are only flushed once the pending requests are served
+  Protocol protocol = Protocol::TEXT;
+  if (argc > 1 and std::string(argv[1]) == "--binary") {
+    protocol = Protocol::BINARY;
+    std::ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+  }
 
   const std::string LOG_FILE("evolution.log");
   const double EVOLUTION_PROBABILITY(0.25);
   const double MUTATION_PROBABILITY(0.1);
+  const double ERROR_THRESHOLD(500);
+  const unsigned int BREEDER_COUNT(2);
+  const unsigned int BATCH_SIZE(4);
 
   Randomizer randomizer;
 
   MetaRulePool pool;
+  ValueIndex index(pool.dimensions().input_count());
+  pool.index_with(&index);
   RandomCovering covering(pool, 1, randomizer);
 
   RandomDecision decisions(randomizer,
 			   EVOLUTION_PROBABILITY,
 			   MUTATION_PROBABILITY);
-  RouletteWheel selection(randomizer);
-  TwoPointCrossover crossover(randomizer);
-  RandomAlleleMutation mutation(randomizer, 10);
 
   std::ofstream log;
   log.open(LOG_FILE, std::ofstream::out);
   LogListener	listener(log);
 
-  Codec codec(pool);
+  // The worker always evolves the snapshots it receives, since the
+  // evolution probability already decided whether to take them. It
+  // breeds batches over several threads, and each thread draws from a
+  // random stream of its own.
+  MetaRulePool worker_pool(pool.dimensions());
+  Codec worker_codec(worker_pool);
+  Randomizer worker_randomizer(randomizer.split());
+  RandomDecision worker_decisions(worker_randomizer,
+				  1.0,
+				  MUTATION_PROBABILITY);
+  RouletteWheel selection(worker_randomizer);
+  TournamentDeletion worker_deletion(worker_randomizer);
 
-  DefaultEvolution evolution(pool,
-			     codec,
-			     decisions,
-			     crossover,
-			     selection,
-			     mutation,
-			     listener);
+  std::deque<Randomizer> streams;
+  std::deque<RandomDecision> breeding_decisions;
+  std::deque<TwoPointCrossover> crossovers;
+  std::deque<RandomAlleleMutation> mutations;
+  std::vector<Breeder> breeders;
+  for (unsigned int index=0 ; index<BREEDER_COUNT ; ++index) {
+    streams.push_back(randomizer.split());
+    breeding_decisions.emplace_back(streams.back(), 1.0, MUTATION_PROBABILITY);
+    crossovers.emplace_back(streams.back());
+    mutations.emplace_back(streams.back());
+    breeders.push_back(Breeder(breeding_decisions.back(),
+			       crossovers.back(),
+			       mutations.back()));
+  }
+
+  BatchEvolution worker_evolution(worker_pool,
+				  worker_codec,
+				  worker_decisions,
+				  selection,
+				  worker_deletion,
+				  breeders,
+				  listener,
+				  BATCH_SIZE);
+
+  // Requests delete on their own thread, so they draw from their own
+  // randomizer rather than from the worker's
+  TournamentDeletion deletion(randomizer);
+  BackgroundEvolution evolution(pool,
+				decisions,
+				deletion,
+				worker_evolution,
+				worker_pool);
+
+  Subsumption subsumption(ERROR_THRESHOLD);
+  evolution.subsume_with(&subsumption);
 
   //NaiveReward reward(0.25);
-  WilsonReward reward(0.25, 500, 2);
-  Application application(cin, cout, evolution, covering, reward);
+  WilsonReward reward(0.25, ERROR_THRESHOLD, 2);
+  Application application(cin, cout, evolution, covering, reward, protocol);
   application.run();
 
   log.close();
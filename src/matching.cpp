@@ -0,0 +1,795 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "matching.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define XCSF_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+
+using namespace xcsf;
+
+
+const unsigned int MatchKernels::MAX_SPECIALISED_INPUTS;
+
+static const unsigned int BLOCK = 64;
+
+
+static inline Level
+level_of(const Vector& input, unsigned int dimension)
+{
+  return static_cast<Level>(static_cast<unsigned int>(input[dimension]));
+}
+
+
+static void
+match_remaining_slots(const Columns&	lower_bounds,
+		      const Columns&	upper_bounds,
+		      const Vector&	input,
+		      unsigned int	first_slot,
+		      Bitmask&		matches)
+{
+  for (unsigned int slot=first_slot ; slot<matches.size() ; ++slot) {
+    bool match = true;
+    for (unsigned int index=0 ; index<lower_bounds.size() and match ; ++index) {
+      const Level value = level_of(input, index);
+      match = lower_bounds[index][slot] <= value and value <= upper_bounds[index][slot];
+    }
+    if (match) {
+      matches.set(slot);
+    }
+  }
+}
+
+
+void
+MatchKernels::scalar(const Columns&	lower_bounds,
+		     const Columns&	upper_bounds,
+		     const Vector&	input,
+		     Bitmask&		matches)
+{
+  const unsigned int full_blocks = matches.size() / BLOCK;
+  std::uint64_t* words = matches.words();
+
+  for (unsigned int block=0 ; block<full_blocks ; ++block) {
+    std::uint64_t word = ~std::uint64_t(0);
+    for (unsigned int index=0 ; index<lower_bounds.size() and word ; ++index) {
+      const Level value = level_of(input, index);
+      const Level* lower = lower_bounds[index].data() + block * BLOCK;
+      const Level* upper = upper_bounds[index].data() + block * BLOCK;
+      std::uint64_t bits = 0;
+      for (unsigned int slot=0 ; slot<BLOCK ; ++slot) {
+	bits |= std::uint64_t((lower[slot] <= value) & (value <= upper[slot])) << slot;
+      }
+      word &= bits;
+    }
+    words[block] = word;
+  }
+
+  match_remaining_slots(lower_bounds, upper_bounds, input, full_blocks * BLOCK, matches);
+}
+
+
+template <unsigned int INPUTS>
+static void
+scalar_with(const Columns&	lower_bounds,
+	    const Columns&	upper_bounds,
+	    const Vector&	input,
+	    Bitmask&		matches)
+{
+  const Level* lower[INPUTS];
+  const Level* upper[INPUTS];
+  Level value[INPUTS];
+  for (unsigned int index=0 ; index<INPUTS ; ++index) {
+    lower[index] = lower_bounds[index].data();
+    upper[index] = upper_bounds[index].data();
+    value[index] = level_of(input, index);
+  }
+
+  const unsigned int full_blocks = matches.size() / BLOCK;
+  std::uint64_t* words = matches.words();
+
+  for (unsigned int block=0 ; block<full_blocks ; ++block) {
+    std::uint64_t word = ~std::uint64_t(0);
+    for (unsigned int index=0 ; index<INPUTS ; ++index) {
+      if (word == 0) break;
+      std::uint64_t bits = 0;
+      for (unsigned int slot=0 ; slot<BLOCK ; ++slot) {
+	const unsigned int offset = block * BLOCK + slot;
+	bits |= std::uint64_t((lower[index][offset] <= value[index])
+			      & (value[index] <= upper[index][offset])) << slot;
+      }
+      word &= bits;
+    }
+    words[block] = word;
+  }
+
+  match_remaining_slots(lower_bounds, upper_bounds, input, full_blocks * BLOCK, matches);
+}
+
+
+/**
+ * Selects, at run time, the instance of KERNEL specialised for a given
+ * number of inputs, from INPUTS down to 1.
+ */
+template <template <unsigned int> class KERNEL, unsigned int INPUTS>
+struct Specialisations
+{
+  static MatchKernel
+  for_inputs(unsigned int input_count)
+  {
+    if (input_count == INPUTS) return &KERNEL<INPUTS>::match;
+    return Specialisations<KERNEL, INPUTS - 1>::for_inputs(input_count);
+  }
+};
+
+
+template <template <unsigned int> class KERNEL>
+struct Specialisations<KERNEL, 0>
+{
+  static MatchKernel
+  for_inputs(unsigned int)
+  {
+    return nullptr;
+  }
+};
+
+
+template <unsigned int INPUTS>
+struct ScalarKernel
+{
+  static void
+  match(const Columns& lower_bounds, const Columns& upper_bounds, const Vector& input, Bitmask& matches)
+  {
+    scalar_with<INPUTS>(lower_bounds, upper_bounds, input, matches);
+  }
+};
+
+
+MatchKernel
+MatchKernels::scalar_for(unsigned int input_count)
+{
+  MatchKernel kernel
+    = Specialisations<ScalarKernel, MAX_SPECIALISED_INPUTS>::for_inputs(input_count);
+  return kernel != nullptr ? kernel : &MatchKernels::scalar;
+}
+
+
+#ifdef XCSF_X86_KERNELS
+
+#if XCSF_VALUE_MAXIMUM <= 0xFF
+
+__attribute__((target("sse4.1")))
+static inline __m128i
+broadcast_128(Level level)
+{
+  return _mm_set1_epi8(static_cast<char>(level));
+}
+
+
+__attribute__((target("sse4.1")))
+static inline std::uint64_t
+contains_16(const Level* lower, const Level* upper, __m128i value)
+{
+  const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lower));
+  const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(upper));
+  const __m128i above = _mm_cmpeq_epi8(_mm_max_epu8(low, value), value);
+  const __m128i below = _mm_cmpeq_epi8(_mm_min_epu8(high, value), value);
+  return static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_and_si128(above, below)));
+}
+
+#else
+
+__attribute__((target("sse4.1")))
+static inline __m128i
+broadcast_128(Level level)
+{
+  return _mm_set1_epi16(static_cast<short>(level));
+}
+
+
+__attribute__((target("sse4.1")))
+static inline __m128i
+contains_8(const Level* lower, const Level* upper, __m128i value)
+{
+  const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lower));
+  const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(upper));
+  const __m128i above = _mm_cmpeq_epi16(_mm_max_epu16(low, value), value);
+  const __m128i below = _mm_cmpeq_epi16(_mm_min_epu16(high, value), value);
+  return _mm_and_si128(above, below);
+}
+
+
+// Two-byte lanes: the 16-bit masks of two loads are packed into bytes
+__attribute__((target("sse4.1")))
+static inline std::uint64_t
+contains_16(const Level* lower, const Level* upper, __m128i value)
+{
+  const __m128i packed = _mm_packs_epi16(contains_8(lower, upper, value),
+					 contains_8(lower + 8, upper + 8, value));
+  return static_cast<std::uint16_t>(_mm_movemask_epi8(packed));
+}
+
+#endif
+
+
+__attribute__((target("sse4.1")))
+void
+MatchKernels::sse4(const Columns&	lower_bounds,
+		   const Columns&	upper_bounds,
+		   const Vector&	input,
+		   Bitmask&		matches)
+{
+  const unsigned int full_blocks = matches.size() / BLOCK;
+  std::uint64_t* words = matches.words();
+
+  for (unsigned int block=0 ; block<full_blocks ; ++block) {
+    std::uint64_t word = ~std::uint64_t(0);
+    for (unsigned int index=0 ; index<lower_bounds.size() and word ; ++index) {
+      const __m128i value = broadcast_128(level_of(input, index));
+      const Level* lower = lower_bounds[index].data() + block * BLOCK;
+      const Level* upper = upper_bounds[index].data() + block * BLOCK;
+      word &= contains_16(lower, upper, value)
+	| contains_16(lower + 16, upper + 16, value) << 16
+	| contains_16(lower + 32, upper + 32, value) << 32
+	| contains_16(lower + 48, upper + 48, value) << 48;
+    }
+    words[block] = word;
+  }
+
+  match_remaining_slots(lower_bounds, upper_bounds, input, full_blocks * BLOCK, matches);
+}
+
+
+#if XCSF_VALUE_MAXIMUM <= 0xFF
+
+__attribute__((target("avx2")))
+static inline __m256i
+broadcast_256(Level level)
+{
+  return _mm256_set1_epi8(static_cast<char>(level));
+}
+
+
+__attribute__((target("avx2")))
+static inline std::uint64_t
+contains_32(const Level* lower, const Level* upper, __m256i value)
+{
+  const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lower));
+  const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(upper));
+  const __m256i above = _mm256_cmpeq_epi8(_mm256_max_epu8(low, value), value);
+  const __m256i below = _mm256_cmpeq_epi8(_mm256_min_epu8(high, value), value);
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(above, below)));
+}
+
+#else
+
+__attribute__((target("avx2")))
+static inline __m256i
+broadcast_256(Level level)
+{
+  return _mm256_set1_epi16(static_cast<short>(level));
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i
+contains_16_lanes(const Level* lower, const Level* upper, __m256i value)
+{
+  const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lower));
+  const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(upper));
+  const __m256i above = _mm256_cmpeq_epi16(_mm256_max_epu16(low, value), value);
+  const __m256i below = _mm256_cmpeq_epi16(_mm256_min_epu16(high, value), value);
+  return _mm256_and_si256(above, below);
+}
+
+
+// Two-byte lanes: packing works within 128-bit halves, hence the
+// permutation restoring the order of the slots
+__attribute__((target("avx2")))
+static inline std::uint64_t
+contains_32(const Level* lower, const Level* upper, __m256i value)
+{
+  const __m256i packed = _mm256_packs_epi16(contains_16_lanes(lower, upper, value),
+					    contains_16_lanes(lower + 16, upper + 16, value));
+  const __m256i ordered = _mm256_permute4x64_epi64(packed, 0xD8);
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(ordered));
+}
+
+#endif
+
+
+__attribute__((target("avx2")))
+void
+MatchKernels::avx2(const Columns&	lower_bounds,
+		   const Columns&	upper_bounds,
+		   const Vector&	input,
+		   Bitmask&		matches)
+{
+  const unsigned int full_blocks = matches.size() / BLOCK;
+  std::uint64_t* words = matches.words();
+
+  for (unsigned int block=0 ; block<full_blocks ; ++block) {
+    std::uint64_t word = ~std::uint64_t(0);
+    for (unsigned int index=0 ; index<lower_bounds.size() and word ; ++index) {
+      const __m256i value = broadcast_256(level_of(input, index));
+      const Level* lower = lower_bounds[index].data() + block * BLOCK;
+      const Level* upper = upper_bounds[index].data() + block * BLOCK;
+      word &= contains_32(lower, upper, value)
+	| contains_32(lower + 32, upper + 32, value) << 32;
+    }
+    words[block] = word;
+  }
+
+  match_remaining_slots(lower_bounds, upper_bounds, input, full_blocks * BLOCK, matches);
+}
+
+
+template <unsigned int INPUTS>
+__attribute__((target("sse4.1")))
+static void
+sse4_with(const Columns&	lower_bounds,
+	  const Columns&	upper_bounds,
+	  const Vector&		input,
+	  Bitmask&		matches)
+{
+  const Level* lower[INPUTS];
+  const Level* upper[INPUTS];
+  __m128i value[INPUTS];
+  for (unsigned int index=0 ; index<INPUTS ; ++index) {
+    lower[index] = lower_bounds[index].data();
+    upper[index] = upper_bounds[index].data();
+    value[index] = broadcast_128(level_of(input, index));
+  }
+
+  const unsigned int full_blocks = matches.size() / BLOCK;
+  std::uint64_t* words = matches.words();
+
+  for (unsigned int block=0 ; block<full_blocks ; ++block) {
+    const unsigned int offset = block * BLOCK;
+    std::uint64_t word = ~std::uint64_t(0);
+    for (unsigned int index=0 ; index<INPUTS ; ++index) {
+      if (word == 0) break;
+      const Level* low = lower[index] + offset;
+      const Level* high = upper[index] + offset;
+      word &= contains_16(low, high, value[index])
+	| contains_16(low + 16, high + 16, value[index]) << 16
+	| contains_16(low + 32, high + 32, value[index]) << 32
+	| contains_16(low + 48, high + 48, value[index]) << 48;
+    }
+    words[block] = word;
+  }
+
+  match_remaining_slots(lower_bounds, upper_bounds, input, full_blocks * BLOCK, matches);
+}
+
+
+template <unsigned int INPUTS>
+__attribute__((target("avx2")))
+static void
+avx2_with(const Columns&	lower_bounds,
+	  const Columns&	upper_bounds,
+	  const Vector&		input,
+	  Bitmask&		matches)
+{
+  const Level* lower[INPUTS];
+  const Level* upper[INPUTS];
+  __m256i value[INPUTS];
+  for (unsigned int index=0 ; index<INPUTS ; ++index) {
+    lower[index] = lower_bounds[index].data();
+    upper[index] = upper_bounds[index].data();
+    value[index] = broadcast_256(level_of(input, index));
+  }
+
+  const unsigned int full_blocks = matches.size() / BLOCK;
+  std::uint64_t* words = matches.words();
+
+  for (unsigned int block=0 ; block<full_blocks ; ++block) {
+    const unsigned int offset = block * BLOCK;
+    std::uint64_t word = ~std::uint64_t(0);
+    for (unsigned int index=0 ; index<INPUTS ; ++index) {
+      if (word == 0) break;
+      const Level* low = lower[index] + offset;
+      const Level* high = upper[index] + offset;
+      word &= contains_32(low, high, value[index])
+	| contains_32(low + 32, high + 32, value[index]) << 32;
+    }
+    words[block] = word;
+  }
+
+  match_remaining_slots(lower_bounds, upper_bounds, input, full_blocks * BLOCK, matches);
+}
+
+
+template <unsigned int INPUTS>
+struct Sse4Kernel
+{
+  static void
+  match(const Columns& lower_bounds, const Columns& upper_bounds, const Vector& input, Bitmask& matches)
+  {
+    sse4_with<INPUTS>(lower_bounds, upper_bounds, input, matches);
+  }
+};
+
+
+template <unsigned int INPUTS>
+struct Avx2Kernel
+{
+  static void
+  match(const Columns& lower_bounds, const Columns& upper_bounds, const Vector& input, Bitmask& matches)
+  {
+    avx2_with<INPUTS>(lower_bounds, upper_bounds, input, matches);
+  }
+};
+
+
+MatchKernel
+MatchKernels::sse4_for(unsigned int input_count)
+{
+  MatchKernel kernel
+    = Specialisations<Sse4Kernel, MAX_SPECIALISED_INPUTS>::for_inputs(input_count);
+  return kernel != nullptr ? kernel : &MatchKernels::sse4;
+}
+
+
+MatchKernel
+MatchKernels::avx2_for(unsigned int input_count)
+{
+  MatchKernel kernel
+    = Specialisations<Avx2Kernel, MAX_SPECIALISED_INPUTS>::for_inputs(input_count);
+  return kernel != nullptr ? kernel : &MatchKernels::avx2;
+}
+
+
+bool
+MatchKernels::supports_sse4(void)
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse4.1");
+}
+
+
+bool
+MatchKernels::supports_avx2(void)
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+void
+MatchKernels::sse4(const Columns&	lower_bounds,
+		   const Columns&	upper_bounds,
+		   const Vector&	input,
+		   Bitmask&		matches)
+{
+  scalar(lower_bounds, upper_bounds, input, matches);
+}
+
+
+void
+MatchKernels::avx2(const Columns&	lower_bounds,
+		   const Columns&	upper_bounds,
+		   const Vector&	input,
+		   Bitmask&		matches)
+{
+  scalar(lower_bounds, upper_bounds, input, matches);
+}
+
+
+MatchKernel
+MatchKernels::sse4_for(unsigned int input_count)
+{
+  MatchKernel kernel = scalar_for(input_count);
+  return kernel != &MatchKernels::scalar ? kernel : &MatchKernels::sse4;
+}
+
+
+MatchKernel
+MatchKernels::avx2_for(unsigned int input_count)
+{
+  MatchKernel kernel = scalar_for(input_count);
+  return kernel != &MatchKernels::scalar ? kernel : &MatchKernels::avx2;
+}
+
+
+bool
+MatchKernels::supports_sse4(void)
+{
+  return false;
+}
+
+
+bool
+MatchKernels::supports_avx2(void)
+{
+  return false;
+}
+
+#endif
+
+
+MatchKernel
+MatchKernels::fastest(void)
+{
+  if (supports_avx2()) return &MatchKernels::avx2;
+  if (supports_sse4()) return &MatchKernels::sse4;
+  return &MatchKernels::scalar;
+}
+
+
+MatchKernel
+MatchKernels::fastest(unsigned int input_count)
+{
+  if (supports_avx2()) return avx2_for(input_count);
+  if (supports_sse4()) return sse4_for(input_count);
+  return scalar_for(input_count);
+}
+
+
+
+PremiseIndex::~PremiseIndex()
+{}
+
+
+
+ValueIndex::ValueIndex(unsigned int input_count)
+  : PremiseIndex()
+  , _input_count(input_count)
+  , _word_count(0)
+  , _bits(input_count * (Value::MAXIMUM + 1))
+{}
+
+
+ValueIndex::~ValueIndex()
+{}
+
+
+std::vector<std::uint64_t>&
+ValueIndex::bits(unsigned int dimension, unsigned int value)
+{
+  return _bits[dimension * (Value::MAXIMUM + 1) + value];
+}
+
+
+const std::vector<std::uint64_t>&
+ValueIndex::bits(unsigned int dimension, unsigned int value) const
+{
+  return _bits[dimension * (Value::MAXIMUM + 1) + value];
+}
+
+
+void
+ValueIndex::grow(unsigned int slot)
+{
+  if (slot / 64 < _word_count) return;
+
+  _word_count = std::max(2 * _word_count, slot / 64 + 1);
+  for (auto& each_bitset: _bits) {
+    each_bitset.resize(_word_count, 0);
+  }
+}
+
+
+void
+ValueIndex::insert(const Columns&	lower_bounds,
+		   const Columns&	upper_bounds,
+		   unsigned int		slot)
+{
+  grow(slot);
+
+  const std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+  for (unsigned int index=0 ; index<_input_count ; ++index) {
+    for (unsigned int value=lower_bounds[index][slot] ;
+	 value<=upper_bounds[index][slot] ;
+	 ++value) {
+      bits(index, value)[slot / 64] |= bit;
+    }
+  }
+}
+
+
+void
+ValueIndex::erase(const Columns&	lower_bounds,
+		  const Columns&	upper_bounds,
+		  unsigned int		slot)
+{
+  if (slot / 64 >= _word_count) return;
+
+  const std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+  for (unsigned int index=0 ; index<_input_count ; ++index) {
+    for (unsigned int value=lower_bounds[index][slot] ;
+	 value<=upper_bounds[index][slot] ;
+	 ++value) {
+      bits(index, value)[slot / 64] &= ~bit;
+    }
+  }
+}
+
+
+void
+ValueIndex::clear(void)
+{
+  for (auto& each_bitset: _bits) {
+    std::fill(each_bitset.begin(), each_bitset.end(), 0);
+  }
+}
+
+
+void
+ValueIndex::match(const Vector& input, Bitmask& matches) const
+{
+  const unsigned int word_count = std::min(_word_count, matches.word_count());
+  std::uint64_t* words = matches.words();
+
+  const std::uint64_t* first = bits(0, level_of(input, 0)).data();
+  std::copy(first, first + word_count, words);
+
+  for (unsigned int index=1 ; index<_input_count ; ++index) {
+    const std::uint64_t* other = bits(index, level_of(input, index)).data();
+    for (unsigned int word=0 ; word<word_count ; ++word) {
+      words[word] &= other[word];
+    }
+  }
+}
+
+
+
+const unsigned int GridIndex::DEFAULT_CELL_WIDTH;
+
+
+GridIndex::Cell::Cell(unsigned int input_count)
+  : lower_bounds(input_count)
+  , upper_bounds(input_count)
+  , slots()
+{}
+
+
+GridIndex::GridIndex(unsigned int input_count, unsigned int cell_width)
+  : PremiseIndex()
+  , _input_count(input_count)
+  , _cell_width(cell_width)
+  , _cell_count(0)
+  , _match(MatchKernels::fastest(input_count))
+  , _cells()
+  , _hits()
+{
+  if (cell_width == 0 or cell_width > Value::MAXIMUM + 1) {
+    std::stringstream message;
+    message << "Invalid cell width " << cell_width
+	    << " (expecting a value in [1, " << Value::MAXIMUM + 1 << "])";
+    throw std::invalid_argument(message.str());
+  }
+
+  _cell_count = Value::MAXIMUM / _cell_width + 1;
+  _cells.resize(_input_count * _cell_count, Cell(_input_count));
+}
+
+
+GridIndex::~GridIndex()
+{}
+
+
+GridIndex::Cell&
+GridIndex::cell(unsigned int dimension, unsigned int value)
+{
+  return _cells[dimension * _cell_count + value / _cell_width];
+}
+
+
+const GridIndex::Cell&
+GridIndex::cell(unsigned int dimension, unsigned int value) const
+{
+  return _cells[dimension * _cell_count + value / _cell_width];
+}
+
+
+void
+GridIndex::insert(const Columns&	lower_bounds,
+		  const Columns&	upper_bounds,
+		  unsigned int		slot)
+{
+  for (unsigned int index=0 ; index<_input_count ; ++index) {
+    const unsigned int lower = lower_bounds[index][slot];
+    const unsigned int upper = upper_bounds[index][slot];
+
+    for (unsigned int value=lower - lower % _cell_width ;
+	 value<=upper ;
+	 value += _cell_width) {
+      Cell& target = cell(index, value);
+      for (unsigned int other=0 ; other<_input_count ; ++other) {
+	target.lower_bounds[other].push_back(lower_bounds[other][slot]);
+	target.upper_bounds[other].push_back(upper_bounds[other][slot]);
+      }
+      target.slots.push_back(slot);
+    }
+  }
+}
+
+
+void
+GridIndex::erase(const Columns&	lower_bounds,
+		 const Columns&	upper_bounds,
+		 unsigned int	slot)
+{
+  for (unsigned int index=0 ; index<_input_count ; ++index) {
+    const unsigned int lower = lower_bounds[index][slot];
+    const unsigned int upper = upper_bounds[index][slot];
+
+    for (unsigned int value=lower - lower % _cell_width ;
+	 value<=upper ;
+	 value += _cell_width) {
+      Cell& target = cell(index, value);
+      auto found = std::find(target.slots.begin(), target.slots.end(), slot);
+      if (found == target.slots.end()) continue;
+
+      const unsigned int position = found - target.slots.begin();
+      for (unsigned int other=0 ; other<_input_count ; ++other) {
+	target.lower_bounds[other][position] = target.lower_bounds[other].back();
+	target.lower_bounds[other].pop_back();
+	target.upper_bounds[other][position] = target.upper_bounds[other].back();
+	target.upper_bounds[other].pop_back();
+      }
+      target.slots[position] = target.slots.back();
+      target.slots.pop_back();
+    }
+  }
+}
+
+
+void
+GridIndex::clear(void)
+{
+  for (auto& each_cell: _cells) {
+    each_cell = Cell(_input_count);
+  }
+}
+
+
+void
+GridIndex::match(const Vector& input, Bitmask& matches) const
+{
+  const Cell* candidates = &cell(0, level_of(input, 0));
+  for (unsigned int index=1 ; index<_input_count ; ++index) {
+    const Cell& other = cell(index, level_of(input, index));
+    if (other.slots.size() < candidates->slots.size()) {
+      candidates = &other;
+    }
+  }
+
+  _hits.reset(candidates->slots.size());
+  _match(candidates->lower_bounds, candidates->upper_bounds, input, _hits);
+
+  const std::uint64_t* words = _hits.words();
+  for (unsigned int word=0 ; word<_hits.word_count() ; ++word) {
+    for (std::uint64_t bits=words[word] ; bits != 0 ; bits &= bits - 1) {
+      const unsigned int slot = candidates->slots[64 * word + __builtin_ctzll(bits)];
+      if (slot < matches.size()) {
+	matches.set(slot);
+      }
+    }
+  }
+}
@@ -0,0 +1,220 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef XCSF_MATCHING_H
+#define XCSF_MATCHING_H
+
+
+#include <vector>
+
+#include "context.h"
+#include "utils.h"
+
+
+namespace xcsf
+{
+
+  typedef std::vector<std::vector<Level>> Columns;
+
+
+  /**
+   * Tests all the rules stored in the given columns (one column per
+   * input dimension, one entry per rule slot) against a single input,
+   * and sets in 'matches' the bit of every slot that contains it. The
+   * size of 'matches' gives the number of slots to consider.
+   */
+  typedef void (*MatchKernel)(const Columns&	lower_bounds,
+			      const Columns&	upper_bounds,
+			      const Vector&	input,
+			      Bitmask&		matches);
+
+
+  /**
+   * Available match kernels. The vectorised ones compare 16 (SSE4.1)
+   * or 32 (AVX2) rules per instruction (half as many with two-byte
+   * levels), and must only be used when the CPU supports them.
+   */
+  struct MatchKernels
+  {
+    static void scalar(const Columns& lower_bounds,
+		       const Columns& upper_bounds,
+		       const Vector& input,
+		       Bitmask& matches);
+
+    static void sse4(const Columns& lower_bounds,
+		     const Columns& upper_bounds,
+		     const Vector& input,
+		     Bitmask& matches);
+
+    static void avx2(const Columns& lower_bounds,
+		     const Columns& upper_bounds,
+		     const Vector& input,
+		     Bitmask& matches);
+
+    /**
+     * Variants specialised at compile time for a fixed number of
+     * inputs, up to MAX_SPECIALISED_INPUTS, with the loop over the
+     * dimensions unrolled and the column pointers and broadcast input
+     * values hoisted out of the loop over the slots. Beyond that, they
+     * return the generic kernel.
+     */
+    static const unsigned int MAX_SPECIALISED_INPUTS = 16;
+
+    static MatchKernel scalar_for(unsigned int input_count);
+    static MatchKernel sse4_for(unsigned int input_count);
+    static MatchKernel avx2_for(unsigned int input_count);
+
+    static bool supports_sse4(void);
+    static bool supports_avx2(void);
+
+    static MatchKernel fastest(void);
+    static MatchKernel fastest(unsigned int input_count);
+  };
+
+
+  /**
+   * Index over the premises of the rules stored in a pool, kept in
+   * sync as slots are acquired and released.
+   */
+  class PremiseIndex
+  {
+  public:
+    virtual ~PremiseIndex();
+
+    virtual void
+      insert(const Columns& lower_bounds,
+	     const Columns& upper_bounds,
+	     unsigned int slot) = 0;
+
+    virtual void
+      erase(const Columns& lower_bounds,
+	    const Columns& upper_bounds,
+	    unsigned int slot) = 0;
+
+    virtual void
+      clear(void) = 0;
+
+    virtual void
+      match(const Vector& input, Bitmask& matches)
+      const = 0;
+
+  };
+
+
+  /**
+   * For each input dimension and each possible value, the set of rule
+   * slots whose interval contains that value. Matching an input is an
+   * AND of one bitset per dimension, regardless of the rule bounds.
+   */
+  class ValueIndex
+    : public PremiseIndex
+  {
+  public:
+    explicit ValueIndex(unsigned int input_count);
+    virtual ~ValueIndex();
+
+    virtual void
+      insert(const Columns& lower_bounds,
+	     const Columns& upper_bounds,
+	     unsigned int slot);
+
+    virtual void
+      erase(const Columns& lower_bounds,
+	    const Columns& upper_bounds,
+	    unsigned int slot);
+
+    virtual void
+      clear(void);
+
+    virtual void
+      match(const Vector& input, Bitmask& matches)
+      const;
+
+  private:
+    std::vector<std::uint64_t>& bits(unsigned int dimension, unsigned int value);
+    const std::vector<std::uint64_t>& bits(unsigned int dimension, unsigned int value) const;
+    void grow(unsigned int slot);
+
+    unsigned int _input_count;
+    unsigned int _word_count;
+    std::vector<std::vector<std::uint64_t>> _bits;
+
+  };
+
+
+  /**
+   * Uniform grid over the value domain of each input dimension. Each
+   * cell keeps, in its own columns, a copy of the premises of the rules
+   * whose interval overlaps it. Matching an input only scans the least
+   * crowded of the cells containing it, with the fastest match kernel,
+   * which pays off as long as rules are narrow compared to the domain.
+   */
+  class GridIndex
+    : public PremiseIndex
+  {
+  public:
+    static const unsigned int DEFAULT_CELL_WIDTH
+      = (Value::MAXIMUM + 1) / 20 > 0 ? (Value::MAXIMUM + 1) / 20 : 1;
+
+    explicit GridIndex(unsigned int input_count,
+		       unsigned int cell_width = DEFAULT_CELL_WIDTH);
+    virtual ~GridIndex();
+
+    virtual void
+      insert(const Columns& lower_bounds,
+	     const Columns& upper_bounds,
+	     unsigned int slot);
+
+    virtual void
+      erase(const Columns& lower_bounds,
+	    const Columns& upper_bounds,
+	    unsigned int slot);
+
+    virtual void
+      clear(void);
+
+    virtual void
+      match(const Vector& input, Bitmask& matches)
+      const;
+
+  private:
+    struct Cell
+    {
+      explicit Cell(unsigned int input_count);
+
+      Columns lower_bounds;
+      Columns upper_bounds;
+      std::vector<unsigned int> slots;
+    };
+
+    Cell& cell(unsigned int dimension, unsigned int value);
+    const Cell& cell(unsigned int dimension, unsigned int value) const;
+
+    unsigned int _input_count;
+    unsigned int _cell_width;
+    unsigned int _cell_count;
+    MatchKernel _match;
+    std::vector<Cell> _cells;
+    mutable Bitmask _hits;
+
+  };
+
+}
+
+#endif
@@ -47,7 +47,7 @@ RandomAlleleMutation::~RandomAlleleMutation()
 
 
 void
-RandomAlleleMutation::operator () (Chromosome& subject, const Allele& locus) const
+RandomAlleleMutation::operator () (Chromosome& subject, const Locus& locus) const
 {
   if (locus >= subject.size()) {
     stringstream err;
@@ -56,12 +56,12 @@ RandomAlleleMutation::operator () (Chromosome& subject, const Allele& locus) con
     throw std::invalid_argument(err.str());
   }
 
-  unsigned int draw = _generate.unsigned_int(0, 2 * _maximum);
+  unsigned int draw = _generate.unsigned_int(0, 2 * _maximum + 1);
   if (draw >= _maximum) {
-    unsigned int update = std::min(draw - _maximum, Value::MAXIMUM - subject[locus]);
+    unsigned int update = std::min(draw - _maximum, Value::MAXIMUM - static_cast<unsigned int>(subject[locus]));
     subject[locus] += update;
   } else {
-    unsigned int update = std::min(_maximum - draw, subject[locus]);
+    unsigned int update = std::min(_maximum - draw, static_cast<unsigned int>(subject[locus]));
     subject[locus] -= update;
   }
   
@@ -34,7 +34,7 @@ namespace xcsf
   public:
     virtual ~AlleleMutation();
 
-    virtual void operator () (Chromosome& subject, const Allele& target) const = 0;
+    virtual void operator () (Chromosome& subject, const Locus& target) const = 0;
   };
 
 
@@ -42,10 +42,10 @@ namespace xcsf
   class RandomAlleleMutation: public AlleleMutation
   {
   public:
-    RandomAlleleMutation(const Randomizer& randomizer, Value maximum=10);
+    RandomAlleleMutation(const Randomizer& randomizer, Value maximum=Value::MAXIMUM / 10);
     virtual ~RandomAlleleMutation();
 
-    virtual void operator () (Chromosome& subject, const Allele& locus) const;
+    virtual void operator () (Chromosome& subject, const Locus& locus) const;
 
   private:
     const Randomizer& _generate;
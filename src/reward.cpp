@@ -19,6 +19,7 @@
 
 #include "reward.h"
 
+#include <algorithm>
 #include <cmath>
 
 
@@ -30,6 +31,66 @@ RewardFunction::~RewardFunction()
 {}
 
 
+void
+RewardFunction::operator () (double reward, RuleSet& rules) const
+{
+  if (rules.is_empty()) return;
+
+  (*this)(reward, rules.pool(), rules.slots());
+}
+
+
+void
+RewardFunction::gather(const MetaRulePool& pool, SlotSpan action_set) const
+{
+  const std::size_t count = action_set.size();
+  _fitnesses.resize(count);
+  _payoffs.resize(count);
+  _errors.resize(count);
+  _accuracies.resize(count);
+  _numerosities.resize(count);
+
+  for (std::size_t index=0 ; index<count ; ++index) {
+    const unsigned int slot = action_set[index];
+    _fitnesses[index] = pool.fitness(slot);
+    _payoffs[index] = pool.payoff(slot);
+    _errors[index] = pool.error(slot);
+    _numerosities[index] = pool.numerosity(slot);
+  }
+}
+
+
+void
+RewardFunction::scatter(MetaRulePool& pool, SlotSpan action_set, double learning_rate) const
+{
+  const std::size_t count = action_set.size();
+  double* const fitness = _fitnesses.data();
+  const double* const accuracy = _accuracies.data();
+
+  double total_accuracy(0);
+  for (std::size_t index=0 ; index<count ; ++index) {
+    total_accuracy += accuracy[index];
+  }
+
+  if (std::isnormal(total_accuracy)) {
+    const double scale = 1. / total_accuracy;
+    for (std::size_t index=0 ; index<count ; ++index) {
+      fitness[index] += learning_rate * (accuracy[index] * scale - fitness[index]);
+    }
+  } else {
+    for (std::size_t index=0 ; index<count ; ++index) {
+      fitness[index] -= learning_rate * fitness[index];
+    }
+  }
+
+  for (std::size_t index=0 ; index<count ; ++index) {
+    const unsigned int slot = action_set[index];
+    pool.update(slot, fitness[index], _payoffs[index], _errors[index]);
+    pool.add_experience(slot);
+  }
+}
+
+
 NaiveReward::NaiveReward(double learning_rate)
   : _learning_rate(learning_rate)
 {}
@@ -40,28 +101,25 @@ NaiveReward::~NaiveReward()
 
 
 void
-NaiveReward::operator () (double reward, RuleSet& rules) const
+NaiveReward::operator () (double reward, MetaRulePool& pool, SlotSpan action_set) const
 {
-  double payoff[rules.size()];
-  double accuracy[rules.size()];
-  double total_accuracy(0);
-
-  for (unsigned int index=0 ; index<rules.size() ; ++index){
-    MetaRule& each_rule = rules[index];
-    payoff[index] = each_rule.payoff() + _learning_rate * (reward - each_rule.payoff());
-    accuracy[index] = std::min(each_rule.payoff(), reward) / std::max(each_rule.payoff(), reward);
-    total_accuracy += accuracy[index];
+  if (action_set.is_empty()) return;
+
+  gather(pool, action_set);
+
+  const std::size_t count = action_set.size();
+  double* const payoff = _payoffs.data();
+  double* const error = _errors.data();
+  double* const accuracy = _accuracies.data();
+  const double* const numerosity = _numerosities.data();
+  for (std::size_t index=0 ; index<count ; ++index) {
+    accuracy[index] = std::min(payoff[index], reward) / std::max(payoff[index], reward)
+      * numerosity[index];
+    payoff[index] += _learning_rate * (reward - payoff[index]);
+    error[index] = 0;
   }
 
-  for(unsigned int index=0 ; index<rules.size() ; ++index) {
-    MetaRule& each_rule = rules[index];
-    double relative_accuracy =
-      (std::isnormal(total_accuracy))
-      ? accuracy[index] / total_accuracy
-      : 0;
-    double fitness = each_rule.fitness() + _learning_rate * (relative_accuracy - each_rule.fitness());
-    each_rule.update(fitness, payoff[index], 0);
-  }
+  scatter(pool, action_set, _learning_rate);
 }
 
 
@@ -69,40 +127,70 @@ WilsonReward::WilsonReward(double learning_rate, double error, double v)
   : _learning_rate(learning_rate)
   , _error(error) 
   , _v(v)
-{}
+  , _integer_exponent(0)
+{
+  if (v >= 1 and v <= MAXIMUM_INTEGER_EXPONENT and v == std::floor(v)) {
+    _integer_exponent = static_cast<unsigned int>(v);
+  }
+}
 
 
 WilsonReward::~WilsonReward()
 {}
 
 
+const unsigned int WilsonReward::MAXIMUM_INTEGER_EXPONENT;
+
+
 void
-WilsonReward::operator () (double reward, RuleSet& rules) const
+WilsonReward::operator () (double reward, MetaRulePool& pool, SlotSpan action_set) const
 {
-  double error[rules.size()];
-  double payoff[rules.size()];
-  double accuracy[rules.size()];
-  double total_accuracy(0);
+  if (action_set.is_empty()) return;
+
+  gather(pool, action_set);
+
+  const std::size_t count = action_set.size();
+  double* const payoff = _payoffs.data();
+  double* const error = _errors.data();
+  for (std::size_t index=0 ; index<count ; ++index) {
+    payoff[index] += _learning_rate * (reward - payoff[index]);
+    error[index] += _learning_rate * std::fabs(reward - payoff[index]);
+  }
+
+  accuracy_powers(count);
+
+  // Accuracy is 0.1 (error / threshold)^-v beyond the error threshold
+  double* const accuracy = _accuracies.data();
+  const double* const numerosity = _numerosities.data();
+  for (std::size_t index=0 ; index<count ; ++index) {
+    const double scaled = error[index] > _error ? 0.1 / accuracy[index] : 1.;
+    accuracy[index] = scaled * numerosity[index];
+  }
+
+  scatter(pool, action_set, _learning_rate);
+}
+
 
-  for (unsigned int index=0 ; index<rules.size() ; ++index){
-    MetaRule& each_rule = rules[index];
-    payoff[index] = each_rule.payoff() + _learning_rate * (reward - each_rule.payoff());
-    error[index] = each_rule.error() + _learning_rate * abs(reward - payoff[index]);
-    
-    accuracy[index] = 1.0;
-    if (error[index] > _error) {
-      accuracy[index] = 0.1 * pow(error[index] / _error, -_v);
+void
+WilsonReward::accuracy_powers(std::size_t count) const
+{
+  const double* const error = _errors.data();
+  double* const power = _accuracies.data();
+  const double inverse_threshold = 1. / _error;
+
+  if (_integer_exponent == 0) {
+    for (std::size_t index=0 ; index<count ; ++index) {
+      power[index] = std::exp(_v * std::log(error[index] * inverse_threshold));
     }
-    total_accuracy += accuracy[index];
+    return;
   }
 
-  for(unsigned int index=0 ; index<rules.size() ; ++index) {
-    MetaRule& each_rule = rules[index];
-    double relative_accuracy =
-      (std::isnormal(total_accuracy))
-      ? accuracy[index] / total_accuracy
-      : 0;
-    double fitness = each_rule.fitness() + _learning_rate * (relative_accuracy - each_rule.fitness());
-    each_rule.update(fitness, payoff[index], error[index]);
+  for (std::size_t index=0 ; index<count ; ++index) {
+    power[index] = error[index] * inverse_threshold;
+  }
+  for (unsigned int round=1 ; round<_integer_exponent ; ++round) {
+    for (std::size_t index=0 ; index<count ; ++index) {
+      power[index] *= error[index] * inverse_threshold;
+    }
   }
 }
@@ -21,6 +21,8 @@
 #define XCSF_REWARD_H
 
 
+#include <vector>
+
 #include "rule.h"
 
 
@@ -32,7 +34,26 @@ namespace xcsf
   public:
     virtual ~RewardFunction();
 
-    virtual void operator () (double reward, RuleSet& rules) const = 0;
+    void operator () (double reward, RuleSet& rules) const;
+
+    virtual void operator () (double reward, MetaRulePool& pool, SlotSpan action_set) const = 0;
+
+  protected:
+    /**
+     * Copies the performance of the action set into contiguous scratch
+     * columns, which the update kernels then scan without any call
+     */
+    void gather(const MetaRulePool& pool, SlotSpan action_set) const;
+
+    /** Derives fitness from accuracy, and writes everything back */
+    void scatter(MetaRulePool& pool, SlotSpan action_set, double learning_rate) const;
+
+    mutable std::vector<double> _fitnesses;
+    mutable std::vector<double> _payoffs;
+    mutable std::vector<double> _errors;
+    mutable std::vector<double> _accuracies;
+    mutable std::vector<double> _numerosities;
+
   };
 
 
@@ -43,7 +64,8 @@ namespace xcsf
     NaiveReward(double learning_rate);
     virtual ~NaiveReward();
 
-    virtual void operator () (double reward, RuleSet& rules) const;
+    using RewardFunction::operator ();
+    virtual void operator () (double reward, MetaRulePool& pool, SlotSpan action_set) const;
     
   private:
     double _learning_rate;
@@ -58,12 +80,19 @@ namespace xcsf
     WilsonReward(double learning_rate, double error, double v);
     virtual ~WilsonReward();
 
-    virtual void operator () (double reward, RuleSet& rules) const;
+    using RewardFunction::operator ();
+    virtual void operator () (double reward, MetaRulePool& pool, SlotSpan action_set) const;
 
   private:
+    /** Powers of the error ratio, by repeated products for small integer exponents */
+    void accuracy_powers(std::size_t count) const;
+
+    static const unsigned int MAXIMUM_INTEGER_EXPONENT = 16;
+
     double _learning_rate;
     double _error;
     double _v;
+    unsigned int _integer_exponent; // 0 unless _v is a small integer
 
   };
 
@@ -21,6 +21,7 @@
 #include <sstream>
 #include <cmath>
 #include <cassert>
+#include <new>
 #include <iomanip>
 
 #include "rule.h"
@@ -276,16 +277,16 @@ xcsf::operator << (ostream& out, const Performance performance)
 
 
 
-MetaRule::MetaRule(const Rule& rule, const Performance& performance)
-  : _rule(rule)
-  , _performance(performance)
+MetaRule::MetaRule(MetaRulePool& pool, unsigned int slot)
+  : _pool(pool)
+  , _slot(slot)
 {}
 
 
 bool
 MetaRule::operator == (const MetaRule& other) const
 {
-  return _rule == other._rule;
+  return as_vector() == other.as_vector();
 }
 
 
@@ -299,79 +300,134 @@ MetaRule::operator != (const MetaRule& other) const
 void
 MetaRule::accept(Formatter& formatter) const
 {
-  formatter.format(_rule, _performance);
+  formatter.format(rule(), performance());
 }
 
 
 vector<unsigned int>
 MetaRule::as_vector(void) const {
-  return static_cast<vector<unsigned int>>(_rule);
+  const Dimensions& dimensions = _pool.dimensions();
+
+  vector<unsigned int> result;
+  for (unsigned int index=0 ; index<dimensions.input_count() ; ++index) {
+    result.push_back(_pool.lower_bounds(index)[_slot]);
+    result.push_back(_pool.upper_bounds(index)[_slot]);
+  }
+
+  for (unsigned int index=0 ; index<dimensions.output_count() ; ++index) {
+    result.push_back(_pool.conclusions(index)[_slot]);
+  }
+
+  return result;
+}
+
+
+Rule
+MetaRule::rule(void) const
+{
+  const Dimensions& dimensions = _pool.dimensions();
+
+  vector<Interval> premises;
+  for (unsigned int index=0 ; index<dimensions.input_count() ; ++index) {
+    premises.push_back(Interval(Value::unchecked(_pool.lower_bounds(index)[_slot]),
+				Value::unchecked(_pool.upper_bounds(index)[_slot])));
+  }
+
+  return Rule(premises, outputs());
+}
+
+
+Performance
+MetaRule::performance(void) const
+{
+  return Performance(fitness(), payoff(), error());
+}
+
+
+MetaRulePool&
+MetaRule::pool(void) const
+{
+  return _pool;
+}
+
+
+unsigned int
+MetaRule::slot(void) const
+{
+  return _slot;
+}
+
+
+unsigned int
+MetaRule::numerosity(void) const
+{
+  return _pool.numerosity(_slot);
 }
 
 
 void
 MetaRule::update(double fitness, double payoff, double error) {
-  assert(std::isfinite(fitness) && "Infinite or NaN fitness");
-  assert(std::isfinite(payoff) && "Infinite or NaN payoff");
-  assert(std::isfinite(error) && "Infinite or NaN error");
-
-  _performance = Performance(fitness, payoff, error);
+  _pool.update(_slot, fitness, payoff, error);
 }
 
 
 const Dimensions&
 MetaRule::dimensions(void) const
 {
-  return _rule.dimensions();
+  return _pool.dimensions();
 }
 
 
 double
 MetaRule::fitness(void) const
 {
-  return _performance.fitness();
+  return _pool.fitness(_slot);
 }
 
 
 double
 MetaRule::error(void) const
 {
-  return _performance.error();
+  return _pool.error(_slot);
 }
 
 
 double
 MetaRule::payoff(void) const
 {
-  return _performance.payoff();
+  return _pool.payoff(_slot);
 }
 
 
 double
 MetaRule::weighted_payoff(void) const
 {
-  return _performance.fitness() * _performance.payoff();
+  return _pool.weighted_payoff(_slot);
 }
 
 
 bool
 MetaRule::match(const Vector& inputs) const
 {
-  return _rule.is_triggered_by(inputs);
+  return _pool.match(_slot, inputs);
 }
 
 
-const Vector&
+Vector
 MetaRule::outputs(void) const
 {
-  return _rule.conclusion();
+  Vector values(_pool.dimensions().output_count());
+  for (unsigned int index=0 ; index<values.size() ; ++index) {
+    values[index] = Value::unchecked(_pool.conclusions(index)[_slot]);
+  }
+  return values;
 }
 
 
 ostream&
 xcsf::operator << (ostream& out, const MetaRule& rule)
 {
-  out << rule._rule << " " << rule._performance;
+  out << rule.rule() << " " << rule.performance();
   return out;
 }
 
@@ -379,14 +435,19 @@ xcsf::operator << (ostream& out, const MetaRule& rule)
 bool
 Comparators::with_lower_weighted_payoff(const MetaRule* left, const MetaRule* right)
 {
-  return left->weighted_payoff() >= right->weighted_payoff();
+  return left->weighted_payoff() > right->weighted_payoff();
 }
 
 
+const unsigned int RuleSet::NO_POSITION;
+
+
 RuleSet::RuleSet(const Dimensions& dimensions, unsigned int capacity)
   : _dimensions(dimensions)
   , _capacity(capacity)
-  , _rules()
+  , _pool(nullptr)
+  , _slots()
+  , _positions()
 {}
 
 
@@ -429,7 +490,8 @@ RuleSet::enforce_capacity(unsigned int count, Comparator comparator)
 bool
 RuleSet::operator == (const RuleSet& other) const
 {
-  return _rules == other._rules;
+  return _pool == other._pool
+    and _slots == other._slots;
 }
 
 
@@ -437,32 +499,58 @@ MetaRule&
 RuleSet::operator [] (unsigned int index) const
 {
   validate(index);
-  return *_rules[index];
+  return _pool->rule(_slots[index]);
+}
+
+
+MetaRulePool&
+RuleSet::pool(void) const
+{
+  if (_pool == nullptr) {
+    throw std::logic_error("This rule set is empty and is bound to no pool.");
+  }
+  return *_pool;
+}
+
+
+unsigned int
+RuleSet::slot(unsigned int index) const
+{
+  validate(index);
+  return _slots[index];
 }
 
 
 std::size_t
 RuleSet::size(void) const
 {
-  return _rules.size();
+  return _slots.size();
 }
 
 
 void
 RuleSet::accept(Formatter& formatter) const
 {
-  formatter.format(_rules);
+  formatter.format(*this);
+}
+
+
+
+SlotSpan
+RuleSet::slots(void) const
+{
+  return SlotSpan(_slots);
 }
 
 
 void
 RuleSet::validate(unsigned int index) const
 {
-  if (index < _rules.size()) return;
+  if (index < _slots.size()) return;
 
   stringstream error;
   error << "Invalid index " << index
-	<< ". there are only " << _rules.size() << " rule(s)." << endl;
+	<< ". there are only " << _slots.size() << " rule(s)." << endl;
   throw std::invalid_argument(error.str());
 }
 
@@ -470,14 +558,14 @@ RuleSet::validate(unsigned int index) const
 bool
 RuleSet::is_empty(void) const
 {
-  return _rules.size() == 0;
+  return _slots.size() == 0;
 }
 
 
 bool
 RuleSet::is_full(void) const
 {
-  return _rules.size() >= _capacity;
+  return _slots.size() >= _capacity;
 }
 
 
@@ -491,21 +579,127 @@ RuleSet::add(MetaRule& rule)
     throw std::invalid_argument(message.str());
   }
 
-  _rules.push_back(&rule);
+  if (_pool == nullptr) {
+    _pool = &rule.pool();
+
+  } else if (_pool != &rule.pool()) {
+    stringstream message;
+    message << "RuleSet cannot accept rule '" << rule
+	    << "', it belongs to another pool.";
+    throw std::invalid_argument(message.str());
+  }
+
+  if (_positions.size() <= rule.slot()) {
+    _positions.resize(rule.slot() + 1, NO_POSITION);
+  }
+  _positions[rule.slot()] = _slots.size();
+  _slots.push_back(rule.slot());
   return *this;
 }
 
 
+MetaRule&
+RuleSet::merge(MetaRule& rule)
+{
+  MetaRule* existing = twin(rule);
+  if (existing == nullptr) {
+    add(rule);
+    return rule;
+  }
+
+  MetaRulePool& rules = pool();
+  rules.set_numerosity(existing->slot(),
+		       existing->numerosity() + rule.numerosity());
+  rules.release(&rule);
+  return *existing;
+}
+
+
+MetaRule*
+RuleSet::twin(const MetaRule& rule) const
+{
+  if (_pool != &rule.pool()) return nullptr;
+
+  for (unsigned int slot = _pool->first_with_content(_pool->content_hash(rule.slot())) ;
+       slot != MetaRulePool::NO_SLOT ;
+       slot = _pool->next_with_content(slot)) {
+    if (slot != rule.slot()
+	and _pool->same_content(slot, rule.slot())
+	and contains(_pool->rule(slot))) {
+      return &_pool->rule(slot);
+    }
+  }
+  return nullptr;
+}
+
+
+bool
+RuleSet::contains(const MetaRule& rule) const
+{
+  return _pool == &rule.pool()
+    and rule.slot() < _positions.size()
+    and _positions[rule.slot()] != NO_POSITION;
+}
+
+
 std::vector<MetaRule*>
 RuleSet::remove(Comparator comparator, unsigned int count)
 {
-  std::sort(_rules.begin(), _rules.end(), comparator);
-  std::vector<MetaRule*> selected_for_removal(_rules.end() - count, _rules.end());
-  _rules.erase(_rules.end() - count, _rules.end());
+  if (count == 0) return std::vector<MetaRule*>();
+
+  // Only the last rules matter, so a partial selection is enough
+  MetaRulePool& rules = pool();
+  std::nth_element(_slots.begin(), _slots.end() - count, _slots.end(),
+		   [&rules, &comparator] (unsigned int left, unsigned int right) {
+		     return comparator(&rules.rule(left), &rules.rule(right));
+		   });
+
+  std::vector<MetaRule*> selected_for_removal;
+  for (auto each_slot = _slots.end() - count ; each_slot != _slots.end() ; ++each_slot) {
+    selected_for_removal.push_back(&rules.rule(*each_slot));
+  }
+  _slots.erase(_slots.end() - count, _slots.end());
+  index_positions();
   return selected_for_removal;
 }
 
 
+bool
+RuleSet::remove(const MetaRule& rule)
+{
+  if (not contains(rule)) return false;
+
+  // Swap with the last rule, so that removal takes constant time
+  const unsigned int slot = rule.slot();
+  const unsigned int position = _positions[slot];
+  _slots[position] = _slots.back();
+  _positions[_slots[position]] = position;
+  _slots.pop_back();
+  _positions[slot] = NO_POSITION;
+  return true;
+}
+
+
+void
+RuleSet::clear(void)
+{
+  for (auto each_slot: _slots) {
+    _positions[each_slot] = NO_POSITION;
+  }
+  _slots.clear();
+}
+
+
+void
+RuleSet::index_positions(void)
+{
+  std::fill(_positions.begin(), _positions.end(), NO_POSITION);
+  for (unsigned int position=0 ; position<_slots.size() ; ++position) {
+    _positions[_slots[position]] = position;
+  }
+}
+
+
 // unsigned int
 // RuleSet::worst(void) const
 // {
@@ -527,8 +721,8 @@ double
 RuleSet::total_fitness(void) const
 {
   double total = 0;
-  for(auto each_rule: _rules) {
-    total += each_rule->fitness();
+  for(auto each_slot: _slots) {
+    total += _pool->fitness(each_slot);
   }
 
   assert(std::isfinite(total) && "Infinite (or NaN) total fitness!");
@@ -540,8 +734,8 @@ double
 RuleSet::total_weighted_payoff(void) const
 {
   double total = 0;
-  for (auto each_rule: _rules) {
-    total += each_rule->weighted_payoff();
+  for (auto each_slot: _slots) {
+    total += _pool->weighted_payoff(each_slot);
   }
 
   assert(std::isfinite(total) && "Non finite total weighted payoff!");
@@ -561,22 +755,74 @@ RuleSet::average_payoff(void) const
 {
   double total_fitness = 0;
   double total_weighted_payoff = 0;
-  for(auto each_rule : _rules) {
-    total_fitness += each_rule->fitness();
-    total_weighted_payoff += each_rule->weighted_payoff();
+  for(auto each_slot : _slots) {
+    total_fitness += _pool->fitness(each_slot);
+    total_weighted_payoff += _pool->weighted_payoff(each_slot);
   }
   return total_weighted_payoff / total_fitness;
 }
 
 
 
+SlotSpan::SlotSpan(const unsigned int* first, std::size_t size)
+  : _first(first)
+  , _size(size)
+{}
+
+
+SlotSpan::SlotSpan(const std::vector<unsigned int>& slots)
+  : _first(slots.data())
+  , _size(slots.size())
+{}
+
+
+const unsigned int*
+SlotSpan::begin(void) const
+{
+  return _first;
+}
+
+
+const unsigned int*
+SlotSpan::end(void) const
+{
+  return _first + _size;
+}
+
+
+std::size_t
+SlotSpan::size(void) const
+{
+  return _size;
+}
+
+
+bool
+SlotSpan::is_empty(void) const
+{
+  return _size == 0;
+}
+
+
+unsigned int
+SlotSpan::operator [] (unsigned int index) const
+{
+  return _first[index];
+}
+
+
+
 ActivationGroup::ActivationGroup(RuleSet& rules, const Vector& context)
-  :RuleSet()
+  :RuleSet(rules.dimensions(), rules.size())
 {
+  if (rules.is_empty()) return;
+
+  Bitmask matches;
+  rules.pool().match(context, matches);
+
   for(unsigned int index=0 ; index<rules.size() ; ++index) {
-    MetaRule& any_rule = rules[index];
-    if (any_rule.match(context)) {
-      add(any_rule);
+    if (matches[rules.slot(index)]) {
+      add(rules[index]);
     }
   }
 }
@@ -587,56 +833,114 @@ ActivationGroup::~ActivationGroup()
 
 
 
-PredictionGroup::PredictionGroup(const RuleSet& rules)
-  :_predictions(),
-   _most_rewarding()
-{
-  _group_rules_by_prediction(rules);
-  _most_rewarding = _find_most_rewarding_rules();
-}
+const unsigned int PredictionArray::NO_SLOT;
 
-RuleSet&
-PredictionGroup::_find_most_rewarding_rules(void) const {
-  std::pair<Vector, RuleSet*> most_rewarding = *_predictions.begin();
-  for(auto any: _predictions) {
-    if (any.second->rewards_more_than(*most_rewarding.second)) {
-      most_rewarding = any;
+
+PredictionArray::PredictionArray()
+  : _entries()
+  , _action_set()
+  , _prediction(0)
+{}
+
+
+PredictionArray::Entry&
+PredictionArray::entry_for(const MetaRulePool& pool, unsigned int slot)
+{
+  const std::uint64_t hash = pool.conclusion_hash(slot);
+  const std::size_t mask = _entries.size() - 1;
+  for (std::size_t position=hash & mask ; ; position=(position + 1) & mask) {
+    Entry& entry = _entries[position];
+    if (entry.slot == NO_SLOT) {
+      entry.hash = hash;
+      entry.slot = slot;
+      return entry;
+    }
+    if (entry.hash == hash and pool.same_conclusions(entry.slot, slot)) {
+      return entry;
     }
   }
-  return *most_rewarding.second;
 }
 
 
 void
-PredictionGroup::_group_rules_by_prediction(const RuleSet& rules) {
-  for(unsigned int index=0 ; index<rules.size() ; index++){
-    const Vector& prediction = rules[index].outputs();
-    if (_predictions.count(prediction) == 0) {
-      RuleSet* group = new RuleSet();
-      _predictions[prediction] = group;
+PredictionArray::select(const MetaRulePool& pool, SlotSpan match_set)
+{
+  std::size_t capacity = 8;
+  while (capacity < 2 * match_set.size()) capacity *= 2;
+  _entries.assign(capacity, Entry { 0, NO_SLOT, 0, 0 });
+
+  for (auto each_slot: match_set) {
+    Entry& entry = entry_for(pool, each_slot);
+    entry.total_fitness += pool.fitness(each_slot);
+    entry.total_weighted_payoff += pool.weighted_payoff(each_slot);
+  }
+
+  // Ties go to the lowest prediction, as if predictions were sorted
+  const unsigned int output_count = pool.dimensions().output_count();
+  auto precedes = [&] (unsigned int slot, unsigned int other_slot) {
+    for (unsigned int index=0 ; index<output_count ; ++index) {
+      const Level* conclusions = pool.conclusions(index);
+      if (conclusions[slot] != conclusions[other_slot]) {
+	return conclusions[slot] < conclusions[other_slot];
+      }
+    }
+    return false;
+  };
+
+  const Entry* best = nullptr;
+  double best_payoff = 0;
+  for (const auto& each_entry: _entries) {
+    if (each_entry.slot == NO_SLOT) continue;
+    // Predictions without fitness yet, such as those of fresh rules,
+    // count as paying nothing rather than NaN, which would never tie
+    const double payoff = each_entry.total_fitness > 0
+      ? each_entry.total_weighted_payoff / each_entry.total_fitness
+      : 0;
+    if (best == nullptr
+	or payoff > best_payoff
+	or (payoff == best_payoff and precedes(each_entry.slot, best->slot))) {
+      best = &each_entry;
+      best_payoff = payoff;
+    }
+  }
+
+  _action_set.clear();
+  if (best == nullptr) return;
+
+  for (auto each_slot: match_set) {
+    if (pool.conclusion_hash(each_slot) == best->hash
+	and pool.same_conclusions(each_slot, best->slot)) {
+      _action_set.push_back(each_slot);
     }
-    _predictions[prediction]->add(rules[index]);
+  }
+
+  if (_prediction.size() != output_count) {
+    _prediction = Vector(output_count);
+  }
+  for (unsigned int index=0 ; index<output_count ; ++index) {
+    _prediction[index] = Value::unchecked(pool.conclusions(index)[best->slot]);
   }
 }
 
 
-PredictionGroup::~PredictionGroup()
+void
+PredictionArray::clear(void)
 {
-  for(auto each : _predictions) {
-    delete each.second;
-  }
+  _action_set.clear();
 }
 
 
 const Vector&
-PredictionGroup::most_rewarding(void) const {
-  return _most_rewarding[0].outputs();
+PredictionArray::prediction(void) const
+{
+  return _prediction;
 }
 
 
-RuleSet&
-PredictionGroup::rules_to_reward(void) const {
-  return _most_rewarding;
+SlotSpan
+PredictionArray::action_set(void) const
+{
+  return SlotSpan(_action_set);
 }
 
 
@@ -647,7 +951,7 @@ Formatter::Formatter(std::ostream& out)
 
 
 void
-Formatter::format(const vector<MetaRule*>& rules)
+Formatter::format(const RuleSet& rules)
 {
   const unsigned int width(6);
   const unsigned int rule_width(27);
@@ -658,8 +962,8 @@ Formatter::format(const vector<MetaRule*>& rules)
        << right << setw(3) << ""
        << left << "Rule"<< endl;
   _out << line << endl;
-  for (auto each_rule: rules) {
-    each_rule->accept(*this);
+  for (unsigned int index=0 ; index<rules.size() ; ++index) {
+    rules[index].accept(*this);
   }
   _out << line << endl;
   _out << rules.size() << " rule(s)." << endl; 
@@ -680,81 +984,568 @@ Formatter::format(const Rule& rule, const Performance& performance)
 }
 
 
-MetaRulePool::MetaRulePool()
-  : _active_rules()
-  , _free_rules()
+bool
+RuleHandle::operator == (const RuleHandle& other) const
+{
+  return slot == other.slot and generation == other.generation;
+}
+
+
+bool
+RuleHandle::operator != (const RuleHandle& other) const
+{
+  return not (*this == other);
+}
+
+
+
+const unsigned int MetaRulePool::SLAB_SIZE;
+const unsigned int MetaRulePool::NO_SLOT;
+const unsigned int MetaRulePool::IN_USE;
+
+
+MetaRulePool::MetaRulePool(const Dimensions& dimensions)
+  : _dimensions(dimensions)
+  , _match(MatchKernels::fastest(dimensions.input_count()))
+  , _index(nullptr)
+  , _lower_bounds(dimensions.input_count())
+  , _upper_bounds(dimensions.input_count())
+  , _conclusions(dimensions.output_count())
+  , _conclusion_hashes()
+  , _content_hashes()
+  , _content_buckets()
+  , _content_links()
+  , _numerosities()
+  , _experiences()
+  , _fitness()
+  , _payoff()
+  , _error()
+  , _weighted_payoffs()
+  , _timestamps()
+  , _clock(0)
+  , _slabs()
+  , _links()
+  , _generations()
+  , _free_head(NO_SLOT)
+  , _active_count(0)
 {}
 
 
 MetaRulePool::~MetaRulePool()
 {
-  for (auto each_rule: _active_rules) {
-    delete each_rule;
+  for (unsigned int slot=0 ; slot<slot_count() ; ++slot) {
+    rule(slot).~MetaRule();
   }
-
-  for (auto each_rule: _free_rules) {
-    delete each_rule;
+  for (auto each_slab: _slabs) {
+    ::operator delete(each_slab);
   }
 }
 
 
+const Dimensions&
+MetaRulePool::dimensions(void) const
+{
+  return _dimensions;
+}
+
+
 MetaRule*
 MetaRulePool::acquire(const Rule& rule, const Performance& performance)
 {
-  if (_free_rules.empty()) {
-    MetaRule *meta_rule = new MetaRule(rule, performance);
-    _active_rules.push_back(meta_rule);
-    return meta_rule;
+  if (rule.dimensions() != _dimensions) {
+    stringstream message;
+    message << "Rule '" << rule << "' does not fit in a pool of dimensions "
+	    << _dimensions << ".";
+    throw std::invalid_argument(message.str());
+  }
+
+  const vector<unsigned int> encoding = static_cast<vector<unsigned int>>(rule);
+  return acquire(vector<Level>(encoding.begin(), encoding.end()), performance);
+}
+
+
+MetaRule*
+MetaRulePool::acquire(const vector<Level>& encoding, const Performance& performance)
+{
+  if (encoding.size() != 2 * _dimensions.input_count() + _dimensions.output_count()) {
+    stringstream message;
+    message << "Encoding of size " << encoding.size()
+	    << " does not match the pool dimensions " << _dimensions << ".";
+    throw std::invalid_argument(message.str());
+  }
+
+  for (auto each_value: encoding) {
+    if (each_value > Value::MAXIMUM) {
+      throw std::invalid_argument("A value cannot exceed the maximum");
+    }
+  }
+
+  if (_free_head == NO_SLOT and _links.size() >= _content_buckets.size()) {
+    rehash_contents(std::max<unsigned int>(SLAB_SIZE, 2 * _content_buckets.size()));
+  }
+
+  unsigned int slot = allocate();
+
+  for (unsigned int index=0 ; index<_dimensions.input_count() ; ++index) {
+    unsigned int lower = encoding[2 * index];
+    unsigned int upper = encoding[2 * index + 1];
+    if (lower > upper) {
+      std::swap(lower, upper);
+    }
+    _lower_bounds[index][slot] = static_cast<Level>(lower);
+    _upper_bounds[index][slot] = static_cast<Level>(upper);
+  }
+
+  // FNV-1a, so that predictions can be grouped without comparing them
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned int index=0 ; index<_dimensions.output_count() ; ++index) {
+    const Level conclusion = static_cast<Level>(encoding[2 * _dimensions.input_count() + index]);
+    _conclusions[index][slot] = conclusion;
+    hash = (hash ^ conclusion) * 1099511628211ULL;
+  }
+  _conclusion_hashes[slot] = hash;
+
+  // The premises, hashed the same way, chain identical rules together
+  for (unsigned int index=0 ; index<_dimensions.input_count() ; ++index) {
+    hash = (hash ^ _lower_bounds[index][slot]) * 1099511628211ULL;
+    hash = (hash ^ _upper_bounds[index][slot]) * 1099511628211ULL;
+  }
+  _content_hashes[slot] = hash;
+  chain_content(slot);
+
+  update(slot, performance.fitness(), performance.payoff(), performance.error());
+  _numerosities[slot] = 1;
+  _experiences[slot] = 0;
+  _timestamps[slot] = _clock;
+
+  if (_index != nullptr) {
+    _index->insert(_lower_bounds, _upper_bounds, slot);
+  }
+
+  return &rule(slot);
+}
+
+
+unsigned int
+MetaRulePool::allocate(void)
+{
+  ++_active_count;
+
+  if (_free_head != NO_SLOT) {
+    const unsigned int slot = _free_head;
+    _free_head = _links[slot];
+    _links[slot] = IN_USE;
+    return slot;
   }
 
-  MetaRule *meta_rule = _free_rules.back();
-  *meta_rule = MetaRule(rule, performance);
-  _free_rules.pop_back();
-  _active_rules.push_back(meta_rule);
-  return meta_rule;
+  const unsigned int slot = _links.size();
+  for (auto& each_column: _lower_bounds) each_column.push_back(0);
+  for (auto& each_column: _upper_bounds) each_column.push_back(0);
+  for (auto& each_column: _conclusions) each_column.push_back(0);
+  _conclusion_hashes.push_back(0);
+  _content_hashes.push_back(0);
+  _content_links.push_back(NO_SLOT);
+  _numerosities.push_back(0);
+  _experiences.push_back(0);
+  _fitness.push_back(0);
+  _payoff.push_back(0);
+  _error.push_back(0);
+  _weighted_payoffs.grow(slot + 1);
+  _timestamps.push_back(0);
+  _links.push_back(IN_USE);
+  _generations.push_back(0);
+
+  if (slot % SLAB_SIZE == 0) {
+    _slabs.push_back(static_cast<MetaRule*>(::operator new(SLAB_SIZE * sizeof(MetaRule))));
+  }
+  new (&rule(slot)) MetaRule(*this, slot);
+  return slot;
 }
 
+
 void
 MetaRulePool::release(MetaRule *rule)
 {
+  if (not owns(rule)) {
+    stringstream message;
+    message << "Rule at address " << rule << " is not managed by this pool!";
+    throw std::invalid_argument(message.str());
+  }
+
   if (is_free(rule)) { return; }
 
-  if (is_active(rule)) {
-    _active_rules.remove(rule);
-    _free_rules.push_back(rule);
-    return;
+  const unsigned int slot = rule->slot();
+  if (_index != nullptr) {
+    _index->erase(_lower_bounds, _upper_bounds, slot);
   }
+  unchain_content(slot);
+  _weighted_payoffs.set(slot, 0);
+  _links[slot] = _free_head;
+  _free_head = slot;
+  ++_generations[slot];
+  --_active_count;
+}
 
-  stringstream message;
-  message << "Rule at address " << rule << " is not managed by this pool!";
-  throw std::invalid_argument(message.str());
+
+bool
+MetaRulePool::owns(const MetaRule* rule) const
+{
+  return rule != nullptr
+    and &rule->_pool == this
+    and rule->_slot < slot_count();
 }
 
 
 bool
 MetaRulePool::is_active(MetaRule* rule) const
 {
-  return std::find(_active_rules.begin(), _active_rules.end(), rule)
-    != std::end(_active_rules);
+  return owns(rule) and _links[rule->slot()] == IN_USE;
 }
 
 bool
 MetaRulePool::is_free(MetaRule* rule) const
 {
-  return std::find(_free_rules.begin(), _free_rules.end(), rule)
-    != std::end(_free_rules);
+  return owns(rule) and _links[rule->slot()] != IN_USE;
 }
 
 
 unsigned int
 MetaRulePool::active_rule_count(void) const
 {
-  return _active_rules.size();
+  return _active_count;
 }
 
 
 unsigned int
 MetaRulePool::free_rule_count(void) const
 {
-  return _free_rules.size();
+  return slot_count() - _active_count;
+}
+
+
+unsigned int
+MetaRulePool::slab_count(void) const
+{
+  return _slabs.size();
+}
+
+
+double
+MetaRulePool::occupancy(void) const
+{
+  if (slot_count() == 0) return 0;
+
+  return static_cast<double>(_active_count) / slot_count();
+}
+
+
+unsigned int
+MetaRulePool::slot_count(void) const
+{
+  return _links.size();
+}
+
+
+MetaRule&
+MetaRulePool::rule(unsigned int slot) const
+{
+  return _slabs[slot / SLAB_SIZE][slot % SLAB_SIZE];
+}
+
+
+RuleHandle
+MetaRulePool::handle(unsigned int slot) const
+{
+  return RuleHandle { slot, _generations[slot] };
+}
+
+
+bool
+MetaRulePool::is_current(const RuleHandle& handle) const
+{
+  return handle.slot < slot_count()
+    and _links[handle.slot] == IN_USE
+    and _generations[handle.slot] == handle.generation;
+}
+
+
+const Level*
+MetaRulePool::lower_bounds(unsigned int input) const
+{
+  return _lower_bounds[input].data();
+}
+
+
+const Level*
+MetaRulePool::upper_bounds(unsigned int input) const
+{
+  return _upper_bounds[input].data();
+}
+
+
+const Level*
+MetaRulePool::conclusions(unsigned int output) const
+{
+  return _conclusions[output].data();
+}
+
+
+std::uint64_t
+MetaRulePool::conclusion_hash(unsigned int slot) const
+{
+  return _conclusion_hashes[slot];
+}
+
+
+bool
+MetaRulePool::same_conclusions(unsigned int slot, unsigned int other_slot) const
+{
+  for (const auto& each_column: _conclusions) {
+    if (each_column[slot] != each_column[other_slot]) return false;
+  }
+  return true;
+}
+
+
+std::uint64_t
+MetaRulePool::content_hash(unsigned int slot) const
+{
+  return _content_hashes[slot];
+}
+
+
+bool
+MetaRulePool::same_content(unsigned int slot, unsigned int other_slot) const
+{
+  if (_content_hashes[slot] != _content_hashes[other_slot]) return false;
+
+  for (unsigned int index=0 ; index<_dimensions.input_count() ; ++index) {
+    if (_lower_bounds[index][slot] != _lower_bounds[index][other_slot]
+	or _upper_bounds[index][slot] != _upper_bounds[index][other_slot]) {
+      return false;
+    }
+  }
+  return same_conclusions(slot, other_slot);
+}
+
+
+unsigned int
+MetaRulePool::first_with_content(std::uint64_t hash) const
+{
+  if (_content_buckets.empty()) return NO_SLOT;
+  return _content_buckets[hash & (_content_buckets.size() - 1)];
+}
+
+
+unsigned int
+MetaRulePool::next_with_content(unsigned int slot) const
+{
+  return _content_links[slot];
+}
+
+
+void
+MetaRulePool::chain_content(unsigned int slot)
+{
+  unsigned int& head = _content_buckets[_content_hashes[slot] & (_content_buckets.size() - 1)];
+  _content_links[slot] = head;
+  head = slot;
+}
+
+
+void
+MetaRulePool::unchain_content(unsigned int slot)
+{
+  unsigned int* link = &_content_buckets[_content_hashes[slot] & (_content_buckets.size() - 1)];
+  while (*link != slot) {
+    link = &_content_links[*link];
+  }
+  *link = _content_links[slot];
+  _content_links[slot] = NO_SLOT;
+}
+
+
+void
+MetaRulePool::rehash_contents(unsigned int bucket_count)
+{
+  _content_buckets.assign(bucket_count, NO_SLOT);
+  for (unsigned int slot=0 ; slot<_links.size() ; ++slot) {
+    if (_links[slot] == IN_USE) {
+      chain_content(slot);
+    }
+  }
+}
+
+
+unsigned int
+MetaRulePool::numerosity(unsigned int slot) const
+{
+  return _numerosities[slot];
+}
+
+
+void
+MetaRulePool::set_numerosity(unsigned int slot, unsigned int numerosity)
+{
+  _numerosities[slot] = numerosity;
+}
+
+
+unsigned int
+MetaRulePool::experience(unsigned int slot) const
+{
+  return _experiences[slot];
+}
+
+
+void
+MetaRulePool::add_experience(unsigned int slot)
+{
+  ++_experiences[slot];
+}
+
+
+bool
+MetaRulePool::subsumes(unsigned int general_slot, unsigned int specific_slot) const
+{
+  for (unsigned int index=0 ; index<_dimensions.input_count() ; ++index) {
+    if (_lower_bounds[index][general_slot] > _lower_bounds[index][specific_slot]
+	or _upper_bounds[index][general_slot] < _upper_bounds[index][specific_slot]) {
+      return false;
+    }
+  }
+  return same_conclusions(general_slot, specific_slot);
+}
+
+
+unsigned int
+MetaRulePool::generality(unsigned int slot) const
+{
+  unsigned int width = 0;
+  for (unsigned int index=0 ; index<_dimensions.input_count() ; ++index) {
+    width += _upper_bounds[index][slot] - _lower_bounds[index][slot];
+  }
+  return width;
+}
+
+
+double
+MetaRulePool::fitness(unsigned int slot) const
+{
+  return _fitness[slot];
+}
+
+
+double
+MetaRulePool::payoff(unsigned int slot) const
+{
+  return _payoff[slot];
+}
+
+
+double
+MetaRulePool::error(unsigned int slot) const
+{
+  return _error[slot];
+}
+
+
+double
+MetaRulePool::weighted_payoff(unsigned int slot) const
+{
+  return _fitness[slot] * _payoff[slot];
+}
+
+
+const FenwickTree&
+MetaRulePool::weighted_payoffs(void) const
+{
+  return _weighted_payoffs;
+}
+
+
+void
+MetaRulePool::update(unsigned int slot, double fitness, double payoff, double error)
+{
+  assert(std::isfinite(fitness) && "Infinite or NaN fitness");
+  assert(std::isfinite(payoff) && "Infinite or NaN payoff");
+  assert(std::isfinite(error) && "Infinite or NaN error");
+
+  _fitness[slot] = fitness;
+  _payoff[slot] = payoff;
+  _error[slot] = error;
+  _weighted_payoffs.set(slot, fitness * payoff);
+}
+
+
+unsigned long
+MetaRulePool::now(void) const
+{
+  return _clock;
+}
+
+
+void
+MetaRulePool::tick(void)
+{
+  ++_clock;
+}
+
+
+unsigned long
+MetaRulePool::timestamp(unsigned int slot) const
+{
+  return _timestamps[slot];
+}
+
+
+void
+MetaRulePool::stamp(unsigned int slot)
+{
+  _timestamps[slot] = _clock;
+}
+
+
+bool
+MetaRulePool::match(unsigned int slot, const Vector& input) const
+{
+  _dimensions.validate_inputs(input);
+
+  for (unsigned int index=0 ; index<_dimensions.input_count() ; ++index) {
+    const Level value = static_cast<unsigned int>(input[index]);
+    if (value < _lower_bounds[index][slot] or _upper_bounds[index][slot] < value) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+void
+MetaRulePool::match(const Vector& input, Bitmask& matches) const
+{
+  _dimensions.validate_inputs(input);
+
+  matches.reset(slot_count());
+  if (_index != nullptr) {
+    _index->match(input, matches);
+    return;
+  }
+  _match(_lower_bounds, _upper_bounds, input, matches);
+}
+
+
+void
+MetaRulePool::index_with(PremiseIndex* index)
+{
+  _index = index;
+  if (_index == nullptr) return;
+
+  _index->clear();
+  for (unsigned int slot=0 ; slot<slot_count() ; ++slot) {
+    if (_links[slot] == IN_USE) {
+      _index->insert(_lower_bounds, _upper_bounds, slot);
+    }
+  }
 }
@@ -21,15 +21,14 @@
 #define XCSF_RULE_H
 
 
-#include <list>
 #include <vector>
-#include <map>
 #include <algorithm>
 #include <functional>
 
 #include "context.h"
 #include "utils.h"
 #include "actions.h"
+#include "matching.h"
 
 
 namespace xcsf {
@@ -111,11 +110,39 @@ namespace xcsf {
   };
 
 
-  class MetaRule
+  class MetaRulePool;
+
+
+  /**
+   * Read-only view over a contiguous sequence of rule slots, such as a
+   * match set or an action set kept in a scratch buffer.
+   */
+  class SlotSpan
   {
   public:
-    MetaRule(const Rule& rule, const Performance& performance);
+    SlotSpan(const unsigned int* first=nullptr, std::size_t size=0);
+    SlotSpan(const std::vector<unsigned int>& slots);
+
+    const unsigned int* begin(void) const;
+    const unsigned int* end(void) const;
+
+    std::size_t size(void) const;
+    bool is_empty(void) const;
+    unsigned int operator [] (unsigned int index) const;
+
+  private:
+    const unsigned int* _first;
+    std::size_t _size;
+
+  };
+
 
+  /**
+   * Handle on a rule stored in the columns of a MetaRulePool
+   */
+  class MetaRule
+  {
+  public:
     bool operator == (const MetaRule& other_rule) const;
     bool operator != (const MetaRule& other_rule) const;
 
@@ -123,23 +150,32 @@ namespace xcsf {
 
     // Conversions
     vector<unsigned int> as_vector(void) const;
+    Rule rule(void) const;
+    Performance performance(void) const;
+
+    MetaRulePool& pool(void) const;
+    unsigned int slot(void) const;
 
     const Dimensions& dimensions(void) const;
     double fitness(void) const;
     double error(void) const;
     double payoff(void) const;
     double weighted_payoff(void) const;
+    unsigned int numerosity(void) const;
 
-    void update(double payoff, double error, double fitness);
+    void update(double fitness, double payoff, double error);
 
     bool match(const Vector& input) const;
-    const Vector& outputs(void) const;
+    Vector outputs(void) const;
 
   private:
+    friend class MetaRulePool;
     friend std::ostream& operator << (std::ostream& out, const MetaRule& rule);
 
-    Rule _rule;
-    Performance _performance;
+    MetaRule(MetaRulePool& pool, unsigned int slot);
+
+    MetaRulePool& _pool;
+    const unsigned int _slot;
 
   };
 
@@ -155,6 +191,12 @@ namespace xcsf {
   };
   
   
+  /**
+   * A set of rules, kept as slot indices in a single MetaRulePool.
+   * The set binds to the pool of the first rule it receives. Its
+   * capacity counts distinct rules, whatever their numerosity, since
+   * those are what matching, reward and evolution go through.
+   */
   class RuleSet
   {
   public:
@@ -173,10 +215,22 @@ namespace xcsf {
     bool operator == (const RuleSet& rules) const;
     MetaRule& operator [] (unsigned int index) const;
 
+    MetaRulePool& pool(void) const;
+    unsigned int slot(unsigned int index) const;
+    SlotSpan slots(void) const;
+
     void accept(Formatter& visitor) const;
 
     RuleSet& add(MetaRule& rule);
+    bool contains(const MetaRule& rule) const;
+
+    // Adds the rule, unless the set holds an identical one, which then
+    // absorbs its numerosity, while the given rule goes back to the pool
+    MetaRule& merge(MetaRule& rule);
+    MetaRule* twin(const MetaRule& rule) const;
     std::vector<MetaRule*> remove(Comparator comparator, unsigned int count);
+    bool remove(const MetaRule& rule);
+    void clear(void);
 
     double total_fitness(void) const; // TODO delete!
     double total_weighted_payoff(void) const;
@@ -187,10 +241,15 @@ namespace xcsf {
 
   private:
     void validate(unsigned int index) const;
+    void index_positions(void);
+
+    static const unsigned int NO_POSITION = static_cast<unsigned int>(-1);
 
     Dimensions _dimensions;
     unsigned int _capacity;
-    vector<MetaRule*> _rules;
+    MetaRulePool* _pool;
+    vector<unsigned int> _slots;
+    vector<unsigned int> _positions; // Position of each pool slot in _slots
   };
 
 
@@ -203,21 +262,40 @@ namespace xcsf {
   };
 
 
-  class PredictionGroup
+  /**
+   * Accumulates, in a single pass over a match set, the fitness and
+   * the weighted payoff of each distinct prediction into an
+   * open-addressing table keyed on the conclusion hashes kept by the
+   * pool. The buffers are reused from one selection to the next.
+   */
+  class PredictionArray
   {
   public:
-    PredictionGroup(const RuleSet& rules);
-    ~PredictionGroup();
+    PredictionArray();
+
+    void select(const MetaRulePool& pool, SlotSpan match_set);
+    void clear(void);
 
-    const Vector& most_rewarding(void) const;
-    RuleSet& rules_to_reward(void) const;
+    const Vector& prediction(void) const;
+    SlotSpan action_set(void) const;
 
   private:
-    void _group_rules_by_prediction(const RuleSet& rules);
-    RuleSet& _find_most_rewarding_rules(void) const;
+    static const unsigned int NO_SLOT = static_cast<unsigned int>(-1);
+
+    struct Entry
+    {
+      std::uint64_t hash;
+      unsigned int slot;
+      double total_fitness;
+      double total_weighted_payoff;
+    };
+
+    Entry& entry_for(const MetaRulePool& pool, unsigned int slot);
+
+    std::vector<Entry> _entries;
+    std::vector<unsigned int> _action_set;
+    Vector _prediction;
 
-    map<Vector, RuleSet*> _predictions;
-    mutable RuleSet _most_rewarding;
   };
 
 
@@ -226,7 +304,7 @@ namespace xcsf {
   public:
     Formatter(std::ostream& out);
 
-    void format(const vector<MetaRule*>& rules);
+    void format(const RuleSet& rules);
     void format(const Rule& rule, const Performance& performance);
 
   private:
@@ -235,14 +313,43 @@ namespace xcsf {
   };
 
 
+  /**
+   * Reference to the rule held in a pool slot, which goes stale once
+   * the slot is released, even if the slot is acquired again later
+   */
+  struct RuleHandle
+  {
+    unsigned int slot;
+    std::uint32_t generation;
+
+    bool operator == (const RuleHandle& other) const;
+    bool operator != (const RuleHandle& other) const;
+  };
+
+
   // TODO: Rename MetaRuleAllocator
+  /**
+   * Column store holding all the rules of a population. Lower bounds,
+   * upper bounds, conclusions and performances are kept in contiguous
+   * arrays, indexed by rule slot, so that matching boils down to a
+   * linear scan over each input dimension. Slots are recycled through
+   * an intrusive free list, and the MetaRule of each slot lives in
+   * slabs of SLAB_SIZE handles, so that acquire, release and
+   * membership checks take constant time.
+   */
   class MetaRulePool
   {
   public:
-    MetaRulePool();
+    static const unsigned int SLAB_SIZE = 256;
+    static const unsigned int NO_SLOT = static_cast<unsigned int>(-1);
+
+    MetaRulePool(const Dimensions& dimensions=Dimensions(1, 1));
     ~MetaRulePool();
 
+    const Dimensions& dimensions(void) const;
+
     MetaRule* acquire(const Rule& rule, const Performance& performance=Performance(0,0,0));
+    MetaRule* acquire(const vector<Level>& encoding, const Performance& performance);
     void release(MetaRule *rule);
 
     bool is_active(MetaRule *rule) const;
@@ -251,12 +358,96 @@ namespace xcsf {
     unsigned int active_rule_count(void) const;
     unsigned int free_rule_count(void) const;
 
+    // Occupancy
+    unsigned int slab_count(void) const;
+    double occupancy(void) const;
+
+    // Slot-level access
+    unsigned int slot_count(void) const;
+    MetaRule& rule(unsigned int slot) const;
+
+    RuleHandle handle(unsigned int slot) const;
+    bool is_current(const RuleHandle& handle) const;
+
+    const Level* lower_bounds(unsigned int input) const;
+    const Level* upper_bounds(unsigned int input) const;
+    const Level* conclusions(unsigned int output) const;
+    std::uint64_t conclusion_hash(unsigned int slot) const;
+    bool same_conclusions(unsigned int slot, unsigned int other_slot) const;
+
+    // Rules chained by content hash, ending with NO_SLOT
+    std::uint64_t content_hash(unsigned int slot) const;
+    bool same_content(unsigned int slot, unsigned int other_slot) const;
+    unsigned int first_with_content(std::uint64_t hash) const;
+    unsigned int next_with_content(unsigned int slot) const;
+
+    // Count of identical rules that each slot stands for
+    unsigned int numerosity(unsigned int slot) const;
+    void set_numerosity(unsigned int slot, unsigned int numerosity);
+
+    // Count of rewards each slot received since it was acquired
+    unsigned int experience(unsigned int slot) const;
+    void add_experience(unsigned int slot);
+
+    bool subsumes(unsigned int general_slot, unsigned int specific_slot) const;
+    unsigned int generality(unsigned int slot) const;
+
+    double fitness(unsigned int slot) const;
+    double payoff(unsigned int slot) const;
+    double error(unsigned int slot) const;
+    double weighted_payoff(unsigned int slot) const;
+    const FenwickTree& weighted_payoffs(void) const;
+
+    void update(unsigned int slot, double fitness, double payoff, double error);
+
+    // Time, in steps, and the time of the last evolution of each rule
+    unsigned long now(void) const;
+    void tick(void);
+    unsigned long timestamp(unsigned int slot) const;
+    void stamp(unsigned int slot);
+
+    bool match(unsigned int slot, const Vector& input) const;
+    void match(const Vector& input, Bitmask& matches) const;
+
+    void index_with(PremiseIndex* index);
+
   private:
     MetaRulePool(const MetaRulePool&);
     MetaRulePool& operator = (const MetaRulePool&);
 
-    std::list<MetaRule*> _active_rules;
-    std::list<MetaRule*> _free_rules;
+    unsigned int allocate(void);
+    void chain_content(unsigned int slot);
+    void unchain_content(unsigned int slot);
+    void rehash_contents(unsigned int bucket_count);
+
+    Dimensions _dimensions;
+    MatchKernel _match;
+    PremiseIndex* _index;
+    Columns _lower_bounds;
+    Columns _upper_bounds;
+    Columns _conclusions;
+    vector<std::uint64_t> _conclusion_hashes;
+    vector<std::uint64_t> _content_hashes;
+    vector<unsigned int> _content_buckets;
+    vector<unsigned int> _content_links;
+    vector<unsigned int> _numerosities;
+    vector<unsigned int> _experiences;
+    vector<double> _fitness;
+    vector<double> _payoff;
+    vector<double> _error;
+    FenwickTree _weighted_payoffs;
+    vector<unsigned long> _timestamps;
+    unsigned long _clock;
+
+    static const unsigned int IN_USE = static_cast<unsigned int>(-2);
+
+    bool owns(const MetaRule* rule) const;
+
+    vector<MetaRule*> _slabs;
+    vector<unsigned int> _links; // Next free slot, or IN_USE
+    vector<std::uint32_t> _generations;
+    unsigned int _free_head;
+    unsigned int _active_count;
 
   };
 
@@ -17,10 +17,12 @@
  */
 
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <cmath>
 #include <cassert>
+#include <limits>
 
 #include "selection.h"
 
@@ -54,6 +56,15 @@ RouletteWheel::operator () (const RuleSet& rules) const
   }
   
   vector<MetaRule*> selected_rules(2);
+
+  const MetaRulePool& pool = rules.pool();
+  if (rules.size() == pool.active_rule_count()) {
+    selected_rules[0] = draw(pool, nullptr);
+    if (selected_rules[0] != nullptr) {
+      selected_rules[1] = draw(pool, selected_rules[0]);
+      if (selected_rules[1] != nullptr) return selected_rules;
+    }
+  }
   
   selected_rules[0] = select_one(rules, nullptr);
   selected_rules[1] = select_one(rules, selected_rules[0]);
@@ -62,6 +73,38 @@ RouletteWheel::operator () (const RuleSet& rules) const
 }
 
 
+MetaRule*
+RouletteWheel::draw(const MetaRulePool& pool, const MetaRule* excluded) const
+{
+  const FenwickTree& weights = pool.weighted_payoffs();
+
+  double excluded_weight = 0, before_excluded = 0;
+  if (excluded != nullptr) {
+    excluded_weight = weights.weight(excluded->slot());
+    before_excluded = weights.prefix(excluded->slot());
+  }
+
+  const double total = weights.total() - excluded_weight;
+  if (total <= 0) return nullptr;
+
+  double threshold = std::max(_generate.uniform() * total,
+			      std::numeric_limits<double>::min());
+  if (threshold > before_excluded) {
+    threshold += excluded_weight;
+  }
+
+  // Rounding errors in the prefix sums may point to a rule without
+  // weight, in which case the caller falls back on a linear scan
+  MetaRule& rule = pool.rule(weights.find(threshold));
+  if (&rule == excluded
+      or weights.weight(rule.slot()) <= 0
+      or not pool.is_active(&rule)) {
+    return nullptr;
+  }
+  return &rule;
+}
+
+
 MetaRule*
 RouletteWheel::select_one(const RuleSet& rules, MetaRule* selected) const
 {
@@ -87,6 +130,60 @@ RouletteWheel::select_one(const RuleSet& rules, MetaRule* selected) const
 }
 
 
+const unsigned int TournamentSelection::DEFAULT_SIZE;
+
+
+TournamentSelection::TournamentSelection(const Randomizer& randomizer, unsigned int size)
+  : Selection()
+  , _generate(randomizer)
+  , _size(size)
+{
+  if (size == 0) {
+    throw std::invalid_argument("A selection tournament requires at least one rule.");
+  }
+}
+
+
+TournamentSelection::~TournamentSelection()
+{}
+
+
+vector<MetaRule*>
+TournamentSelection::operator () (const RuleSet& rules) const
+{
+  if (rules.size() < 2) {
+    stringstream error;
+    error << "Selecting parents requires at least two rules (found " << rules.size() << ")." << endl;
+    throw invalid_argument(error.str());
+  }
+
+  vector<MetaRule*> selected_rules(2);
+  selected_rules[0] = select_one(rules, nullptr);
+  selected_rules[1] = select_one(rules, selected_rules[0]);
+  return selected_rules;
+}
+
+
+MetaRule*
+TournamentSelection::select_one(const RuleSet& rules, const MetaRule* excluded) const
+{
+  MetaRule* winner = nullptr;
+  for (unsigned int round=0 ; round<_size ; ++round) {
+    unsigned int index = _generate.index(rules.size());
+    if (&rules[index] == excluded) {
+      index = (index + 1) % rules.size();
+    }
+
+    MetaRule* contender = &rules[index];
+    if (winner == nullptr
+	or contender->weighted_payoff() > winner->weighted_payoff()) {
+      winner = contender;
+    }
+  }
+  return winner;
+}
+
+
 DummySelection::~DummySelection()
 {}
 
@@ -106,3 +203,56 @@ DummySelection::operator () (const RuleSet& rules) const
   return selection;  
 }
 
+
+
+Deletion::~Deletion()
+{}
+
+
+WorstDeletion::~WorstDeletion()
+{}
+
+
+vector<MetaRule*>
+WorstDeletion::operator () (RuleSet& rules, unsigned int count) const
+{
+  return rules.remove(Comparators::with_lower_weighted_payoff,
+		      std::min<unsigned int>(count, rules.size()));
+}
+
+
+const unsigned int TournamentDeletion::DEFAULT_SIZE;
+
+
+TournamentDeletion::TournamentDeletion(const Randomizer& randomizer, unsigned int size)
+  : Deletion()
+  , _generate(randomizer)
+  , _size(size)
+{
+  if (size == 0) {
+    throw std::invalid_argument("A deletion tournament requires at least one rule.");
+  }
+}
+
+
+TournamentDeletion::~TournamentDeletion()
+{}
+
+
+vector<MetaRule*>
+TournamentDeletion::operator () (RuleSet& rules, unsigned int count) const
+{
+  vector<MetaRule*> deleted;
+  while (deleted.size() < count and not rules.is_empty()) {
+    MetaRule* weakest = &rules[_generate.index(rules.size())];
+    for (unsigned int round=1 ; round<_size ; ++round) {
+      MetaRule* contender = &rules[_generate.index(rules.size())];
+      if (contender->weighted_payoff() < weakest->weighted_payoff()) {
+	weakest = contender;
+      }
+    }
+    rules.remove(*weakest);
+    deleted.push_back(weakest);
+  }
+  return deleted;
+}
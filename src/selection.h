@@ -39,6 +39,12 @@ namespace xcsf
   };
 
 
+  /**
+   * Roulette wheel on weighted payoff. When the rule set holds all the
+   * rules of its pool, parents are found in logarithmic time through
+   * the prefix sums the pool maintains. Otherwise, the wheel is a
+   * linear scan.
+   */
   class RouletteWheel: public Selection
   {
   public:
@@ -49,11 +55,34 @@ namespace xcsf
 
   private:
     MetaRule* select_one(const RuleSet& rules, MetaRule* selected) const;
+    MetaRule* draw(const MetaRulePool& pool, const MetaRule* excluded) const;
     const Randomizer& _generate;
     
   };
 
 
+  /**
+   * Picks each parent as the best of a few rules drawn at random, so
+   * that the cost does not depend on the size of the rule set
+   */
+  class TournamentSelection: public Selection
+  {
+  public:
+    static const unsigned int DEFAULT_SIZE = 4;
+
+    TournamentSelection(const Randomizer& generator, unsigned int size=DEFAULT_SIZE);
+    virtual ~TournamentSelection();
+
+    virtual vector<MetaRule*> operator () (const RuleSet& rules) const;
+
+  private:
+    MetaRule* select_one(const RuleSet& rules, const MetaRule* excluded) const;
+    const Randomizer& _generate;
+    const unsigned int _size;
+
+  };
+
+
   class DummySelection: public Selection
   {
   public:
@@ -62,6 +91,56 @@ namespace xcsf
     virtual vector<MetaRule*> operator () (const RuleSet& rules) const;
   };
 
+
+  /**
+   * Strategy that picks the rules to delete from a rule set, and
+   * removes them from it. Releasing them is left to the caller.
+   */
+  class Deletion
+  {
+  public:
+    virtual ~Deletion();
+
+    virtual vector<MetaRule*> operator () (RuleSet& rules, unsigned int count) const = 0;
+
+  };
+
+
+  /**
+   * Deletes the rules of lowest weighted payoff, through a linear
+   * partial selection
+   */
+  class WorstDeletion: public Deletion
+  {
+  public:
+    virtual ~WorstDeletion();
+
+    virtual vector<MetaRule*> operator () (RuleSet& rules, unsigned int count) const;
+
+  };
+
+
+  /**
+   * Deletes, for each rule to remove, the weakest of a few rules drawn
+   * at random, so that the cost does not depend on the size of the
+   * rule set
+   */
+  class TournamentDeletion: public Deletion
+  {
+  public:
+    static const unsigned int DEFAULT_SIZE = 4;
+
+    TournamentDeletion(const Randomizer& generator, unsigned int size=DEFAULT_SIZE);
+    virtual ~TournamentDeletion();
+
+    virtual vector<MetaRule*> operator () (RuleSet& rules, unsigned int count) const;
+
+  private:
+    const Randomizer& _generate;
+    const unsigned int _size;
+
+  };
+
   
 }
 
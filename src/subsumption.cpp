@@ -0,0 +1,104 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "subsumption.h"
+
+
+using namespace xcsf;
+
+
+const unsigned int Subsumption::DEFAULT_EXPERIENCE;
+
+
+Subsumption::Subsumption(double error_threshold, unsigned int experience_threshold)
+  : _error_threshold(error_threshold)
+  , _experience_threshold(experience_threshold)
+  , _matches()
+{}
+
+
+Subsumption::~Subsumption()
+{}
+
+
+bool
+Subsumption::can_subsume(const MetaRulePool& pool, unsigned int slot) const
+{
+  return pool.experience(slot) > _experience_threshold
+    and pool.error(slot) < _error_threshold;
+}
+
+
+MetaRule*
+Subsumption::subsumer(const RuleSet& rules, const MetaRule& rule) const
+{
+  if (rules.is_empty() or &rules.pool() != &rule.pool()) return nullptr;
+
+  const MetaRulePool& pool = rules.pool();
+  const unsigned int input_count = pool.dimensions().input_count();
+  Vector corner(input_count);
+  for (unsigned int index=0 ; index<input_count ; ++index) {
+    corner[index] = Value::unchecked(pool.lower_bounds(index)[rule.slot()]);
+  }
+  pool.match(corner, _matches);
+
+  const std::uint64_t* words = _matches.words();
+  for (unsigned int word=0 ; word<_matches.word_count() ; ++word) {
+    for (std::uint64_t bits = words[word] ; bits != 0 ; bits &= bits - 1) {
+      const unsigned int slot = 64 * word + __builtin_ctzll(bits);
+      if (slot != rule.slot()
+	  and can_subsume(pool, slot)
+	  and pool.subsumes(slot, rule.slot())
+	  and rules.contains(pool.rule(slot))) {
+	return &pool.rule(slot);
+      }
+    }
+  }
+  return nullptr;
+}
+
+
+void
+Subsumption::operator () (RuleSet& rules, SlotSpan action_set) const
+{
+  if (action_set.is_empty()) return;
+
+  MetaRulePool& pool = rules.pool();
+  unsigned int general = MetaRulePool::NO_SLOT;
+  for (auto each_slot: action_set) {
+    if (can_subsume(pool, each_slot)
+	and rules.contains(pool.rule(each_slot))
+	and (general == MetaRulePool::NO_SLOT
+	     or pool.generality(each_slot) > pool.generality(general))) {
+      general = each_slot;
+    }
+  }
+  if (general == MetaRulePool::NO_SLOT) return;
+
+  for (auto each_slot: action_set) {
+    MetaRule& each_rule = pool.rule(each_slot);
+    if (each_slot != general
+	and rules.contains(each_rule)
+	and pool.subsumes(general, each_slot)) {
+      pool.set_numerosity(general, pool.numerosity(general) + pool.numerosity(each_slot));
+      rules.remove(each_rule);
+      pool.release(&each_rule);
+    }
+  }
+}
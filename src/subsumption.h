@@ -0,0 +1,67 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef XCSF_SUBSUMPTION_H
+#define XCSF_SUBSUMPTION_H
+
+
+#include "utils.h"
+#include "rule.h"
+
+
+namespace xcsf
+{
+
+  /**
+   * Absorbs specific rules into the more general ones that are both
+   * accurate and experienced, by adding their numerosity. Subsumers of
+   * a new rule must contain its lower corner, so candidates come from
+   * a single match query, which the pool answers through its index.
+   *
+   * Unlike the usual GA subsumption, the subsumer of a child may be
+   * any rule of the set, not only one of its parents: the background
+   * evolution applies children long after their parents were picked,
+   * in a rule set they may have left. This puts a stronger pressure
+   * towards general rules.
+   */
+  class Subsumption
+  {
+  public:
+    static const unsigned int DEFAULT_EXPERIENCE = 20;
+
+    Subsumption(double error_threshold, unsigned int experience_threshold=DEFAULT_EXPERIENCE);
+    virtual ~Subsumption();
+
+    bool can_subsume(const MetaRulePool& pool, unsigned int slot) const;
+
+    MetaRule* subsumer(const RuleSet& rules, const MetaRule& rule) const;
+
+    void operator () (RuleSet& rules, SlotSpan action_set) const;
+
+  private:
+    const double _error_threshold;
+    const unsigned int _experience_threshold;
+    mutable Bitmask _matches;
+
+  };
+
+}
+
+
+#endif
@@ -19,8 +19,8 @@
 
 #include "utils.h"
 
-#include <ctime>
-#include <cstdlib>
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 
 using namespace xcsf;
@@ -95,9 +95,190 @@ xcsf::operator << (ostream& out, const Interval& interval)
 
 
 
+Bitmask::Bitmask(unsigned int size)
+  : _size(0)
+  , _words()
+{
+  reset(size);
+}
+
+
+void
+Bitmask::reset(unsigned int size)
+{
+  _size = size;
+  _words.assign((size + 63) / 64, 0);
+}
+
+
+unsigned int
+Bitmask::size(void) const
+{
+  return _size;
+}
+
+
+unsigned int
+Bitmask::word_count(void) const
+{
+  return _words.size();
+}
+
+
+bool
+Bitmask::operator [] (unsigned int index) const
+{
+  return (_words[index / 64] >> (index % 64)) & 1;
+}
+
+
+void
+Bitmask::set(unsigned int index)
+{
+  _words[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+
+std::uint64_t*
+Bitmask::words(void)
+{
+  return _words.data();
+}
+
+
+const std::uint64_t*
+Bitmask::words(void) const
+{
+  return _words.data();
+}
+
+
+
+FenwickTree::FenwickTree()
+  : _weights()
+  , _tree(1, 0.)
+{}
+
+
+unsigned int
+FenwickTree::size(void) const
+{
+  return _weights.size();
+}
+
+
+void
+FenwickTree::grow(unsigned int size)
+{
+  if (size <= _weights.size()) return;
+  _weights.resize(size, 0.);
+  if (size < _tree.size()) return;
+
+  // The tree covers a power of two of weights, so that it is only
+  // rebuilt, in linear time, when the capacity doubles
+  unsigned int capacity = 1;
+  while (capacity < size) capacity *= 2;
+  _tree.assign(capacity + 1, 0.);
+  for (unsigned int node=1 ; node<=capacity ; ++node) {
+    if (node <= size) _tree[node] += _weights[node - 1];
+    const unsigned int parent = node + (node & -node);
+    if (parent <= capacity) _tree[parent] += _tree[node];
+  }
+}
+
+
+double
+FenwickTree::weight(unsigned int index) const
+{
+  return _weights[index];
+}
+
+
+void
+FenwickTree::set(unsigned int index, double weight)
+{
+  weight = std::max(weight, 0.);
+  const double delta = weight - _weights[index];
+  _weights[index] = weight;
+  for (unsigned int node=index+1 ; node<_tree.size() ; node += node & -node) {
+    _tree[node] += delta;
+  }
+}
+
+
+double
+FenwickTree::prefix(unsigned int count) const
+{
+  double sum = 0.;
+  for (unsigned int node=count ; node>0 ; node -= node & -node) {
+    sum += _tree[node];
+  }
+  return sum;
+}
+
+
+double
+FenwickTree::total(void) const
+{
+  return prefix(size());
+}
+
+
+unsigned int
+FenwickTree::find(double threshold) const
+{
+  unsigned int step = 1;
+  while (step * 2 < _tree.size()) step *= 2;
+
+  // Largest count whose prefix stays below the threshold
+  unsigned int count = 0;
+  for ( ; step>0 ; step /= 2) {
+    if (count + step < _tree.size() and _tree[count + step] < threshold) {
+      count += step;
+      threshold -= _tree[count];
+    }
+  }
+  return std::min<unsigned int>(count, size() - 1);
+}
+
+
+
+namespace {
+
+  std::uint64_t
+  split_mix(std::uint64_t& state)
+  {
+    std::uint64_t bits = (state += 0x9E3779B97F4A7C15ULL);
+    bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+    return bits ^ (bits >> 31);
+  }
+
+  inline std::uint64_t
+  rotate_left(std::uint64_t bits, int count)
+  {
+    return (bits << count) | (bits >> (64 - count));
+  }
+
+  inline double
+  to_uniform(std::uint64_t bits)
+  {
+    return static_cast<double>(bits >> 11) / 9007199254740992.0;
+  }
+
+}
+
+
 Randomizer::Randomizer()
+  : Randomizer(std::chrono::system_clock::now().time_since_epoch().count())
+{}
+
+
+Randomizer::Randomizer(std::uint64_t seed)
 {
-  std::srand(std::time(0));
+  for (auto& each_word: _state) {
+    each_word = split_mix(seed);
+  }
 }
 
 
@@ -108,17 +289,97 @@ Randomizer::~Randomizer()
 unsigned int
 Randomizer::unsigned_int(unsigned int lower, unsigned int upper) const
 {
-  double value = lower + (upper - lower - 1) * uniform();
-  return static_cast<unsigned int>(value);
+  return lower + index(upper - lower);
+}
+
+
+unsigned int
+Randomizer::index(unsigned int count) const
+{
+  // Draws of exactly 1, as canned sequences may yield, stay in range
+  const unsigned int position = static_cast<unsigned int>(count * uniform());
+  return std::min(count - 1, position);
+}
+
+
+void
+Randomizer::unsigned_ints(unsigned int*	values,
+			  unsigned int	count,
+			  unsigned int	lower,
+			  unsigned int	upper) const
+{
+  const unsigned int BLOCK = 64;
+  double draws[BLOCK];
+  const unsigned int range = upper - lower;
+  for (unsigned int start=0 ; start<count ; start += BLOCK) {
+    const unsigned int size = std::min(BLOCK, count - start);
+    uniforms(draws, size);
+    for (unsigned int index=0 ; index<size ; ++index) {
+      const unsigned int position = static_cast<unsigned int>(range * draws[index]);
+      values[start + index] = lower + std::min(range - 1, position);
+    }
+  }
 }
 
 
 double
 Randomizer::uniform(void) const
 {
-  return static_cast<double>(std::rand()) / RAND_MAX;
+  return to_uniform(next());
 }
-  
 
 
+void
+Randomizer::uniforms(double* values, unsigned int count) const
+{
+  for (unsigned int index=0 ; index<count ; ++index) {
+    values[index] = to_uniform(next());
+  }
+}
 
+
+void
+Randomizer::jump(void)
+{
+  static const std::uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+					0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+  std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+  for (auto each_word: JUMP) {
+    for (int bit=0 ; bit<64 ; ++bit) {
+      if (each_word & (1ULL << bit)) {
+	for (int index=0 ; index<4 ; ++index) {
+	  jumped[index] ^= _state[index];
+	}
+      }
+      next();
+    }
+  }
+  std::copy(jumped, jumped + 4, _state);
+}
+
+
+Randomizer
+Randomizer::split(void)
+{
+  Randomizer stream(*this);
+  jump();
+  return stream;
+}
+
+
+std::uint64_t
+Randomizer::next(void) const
+{
+  const std::uint64_t result = rotate_left(_state[1] * 5, 7) * 9;
+  const std::uint64_t shifted = _state[1] << 17;
+
+  _state[2] ^= _state[0];
+  _state[3] ^= _state[1];
+  _state[1] ^= _state[2];
+  _state[0] ^= _state[3];
+  _state[2] ^= shifted;
+  _state[3] = rotate_left(_state[3], 45);
+
+  return result;
+}
@@ -21,6 +21,9 @@
 #define XCSF_UTILS_H
 
 
+#include <cstdint>
+#include <vector>
+
 #include "context.h"
 
 
@@ -52,15 +55,96 @@ namespace xcsf
   };
   
   
+  /**
+   * Fixed-size set of bits, packed in 64-bit words
+   */
+  class Bitmask
+  {
+  public:
+    explicit Bitmask(unsigned int size=0);
+
+    void reset(unsigned int size);
+
+    unsigned int size(void) const;
+    unsigned int word_count(void) const;
+
+    bool operator [] (unsigned int index) const;
+    void set(unsigned int index);
+
+    std::uint64_t* words(void);
+    const std::uint64_t* words(void) const;
+
+  private:
+    unsigned int _size;
+    std::vector<std::uint64_t> _words;
+
+  };
+
+
+  /**
+   * Non-negative weights, stored in a Fenwick tree so that setting a
+   * weight, summing a prefix and finding where a cumulative weight is
+   * reached all take logarithmic time
+   */
+  class FenwickTree
+  {
+  public:
+    FenwickTree();
+
+    unsigned int size(void) const;
+    void grow(unsigned int size);
+
+    double weight(unsigned int index) const;
+    void set(unsigned int index, double weight);
+
+    double prefix(unsigned int count) const;
+    double total(void) const;
+    unsigned int find(double threshold) const;
+
+  private:
+    std::vector<double> _weights;
+    std::vector<double> _tree;
+
+  };
+
+
+  /**
+   * Pseudo-random generator (xoshiro256**) with a state of its own.
+   * Generators seeded alike draw the same numbers, and split() yields
+   * streams that never overlap, one per thread. Subclasses that
+   * override uniform must override uniforms as well.
+   */
   class Randomizer
   {
   public:
     Randomizer();
+    explicit Randomizer(std::uint64_t seed);
     virtual ~Randomizer();
 
+    /** Integer in [lower, upper), each equally likely, for lower < upper */
     unsigned int unsigned_int(unsigned int lower=0, unsigned int upper=100) const;
 
-    virtual double uniform(void) const;    
+    /** Position in [0, count), each equally likely, for count > 0 */
+    unsigned int index(unsigned int count) const;
+
+    /** Fills values with count draws of unsigned_int(lower, upper) */
+    void unsigned_ints(unsigned int* values, unsigned int count,
+		       unsigned int lower=0, unsigned int upper=100) const;
+
+    virtual double uniform(void) const;
+    virtual void uniforms(double* values, unsigned int count) const;
+
+    /** Skips 2^128 draws ahead */
+    void jump(void);
+
+    /** Generator drawing the next 2^128 numbers, which this one skips */
+    Randomizer split(void);
+
+  private:
+    std::uint64_t next(void) const;
+
+    mutable std::uint64_t _state[4];
+
   };
   
 }
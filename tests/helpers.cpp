@@ -18,9 +18,50 @@
 
 
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 #include "helpers.h"
 
 
+static std::atomic<unsigned long> allocations(0);
+
+
+void*
+operator new(std::size_t size)
+{
+  ++allocations;
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) throw std::bad_alloc();
+  return memory;
+}
+
+
+void*
+operator new[](std::size_t size)
+{
+  ++allocations;
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) throw std::bad_alloc();
+  return memory;
+}
+
+
+void
+operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+
+void
+operator delete[](void* memory) noexcept
+{
+  std::free(memory);
+}
+
+
 FakeCovering::~FakeCovering()
 {}
 
@@ -33,16 +74,13 @@ FakeCovering::operator () (RuleSet& rules, const Vector& context) const
 
 TestRuleFactory::TestRuleFactory()
   : Evolution()
+  , _pool()
   , _rules()
 {}
 
 
 TestRuleFactory::~TestRuleFactory()
-{
-  for (auto each_rule: _rules) {
-    delete each_rule;
-  }
-}
+{}
 
 
 void
@@ -61,17 +99,31 @@ TestRuleFactory::evolve(RuleSet& rules) const
 void
 TestRuleFactory::create_rule_for(RuleSet& rules, const Vector& context) const
 {
-  MetaRule* covering_rule = new MetaRule(Rule({ Interval(0, 100) }, { 50 }),
-					 Performance(1., 1., 1.));
-  _rules.push_back(covering_rule);
+  MetaRule* covering_rule = _pool.acquire(Rule({ Interval(0, 100) }, { 50 }),
+					  Performance(1., 1., 1.));
   rules.add(*covering_rule);
 }
 
 
-void
-TestRuleFactory::define(MetaRule& rule)
+MetaRule*
+TestRuleFactory::define(const Rule& rule, const Performance& performance)
+{
+  MetaRule* meta_rule = _pool.acquire(rule, performance);
+  _rules.push_back(meta_rule);
+  return meta_rule;
+}
+
+
+
+AllocationCounter::AllocationCounter()
+  : _start(allocations)
+{}
+
+
+unsigned long
+AllocationCounter::count(void) const
 {
-  _rules.push_back(&rule);
+  return allocations - _start;
 }
 
 
@@ -96,6 +148,16 @@ TestableRandomizer::uniform(void) const
   return random_number;
 }
 
+
+void
+TestableRandomizer::uniforms(double* values, unsigned int count) const
+{
+  for (unsigned int index=0 ; index<count ; ++index) {
+    values[index] = uniform();
+  }
+}
+
+
 void
 TestableRandomizer::sequence(vector<double> sequence)
 {
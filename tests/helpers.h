@@ -56,10 +56,29 @@ public:
   virtual void evolve(RuleSet& rules) const;
   virtual void create_rule_for(RuleSet& rules, const Vector& context) const;
 
-  void define(MetaRule& rule);
+  MetaRule* define(const Rule& rule, const Performance& performance);
 
 private:
-  mutable vector<MetaRule*> _rules;
+  mutable MetaRulePool _pool;
+  vector<MetaRule*> _rules;
+
+};
+
+
+
+/**
+ * Counts the heap allocations (calls to the global operator new and
+ * operator new[]) made since its creation.
+ */
+class AllocationCounter
+{
+public:
+  AllocationCounter();
+
+  unsigned long count(void) const;
+
+private:
+  unsigned long _start;
 
 };
 
@@ -72,6 +91,7 @@ public:
   virtual ~TestableRandomizer();
 
   virtual double uniform(void) const;
+  virtual void uniforms(double* values, unsigned int count) const;
 
   void sequence(vector<double> sequence);
 
@@ -44,9 +44,8 @@ TEST_GROUP(OneRuleAgent)
   {
     covering = new FakeCovering();
     reward = new WilsonReward(0.25, 500, 2);
-    rule = new MetaRule(Rule({Interval(0, 50)}, predictions),
-			Performance(1.0, 1.0, 1.0));
-    evolution.define(*rule);
+    rule = evolution.define(Rule({Interval(0, 50)}, predictions),
+			    Performance(1.0, 1.0, 1.0));
     agent = new Agent(evolution, *covering, *reward);
   }
 
@@ -82,6 +81,42 @@ TEST(OneRuleAgent, test_reward)
 
 
 
+/**
+ * Records the room requested before covering
+ */
+class RoomRecorder
+  : public TestRuleFactory
+{
+public:
+  RoomRecorder()
+    : TestRuleFactory()
+    , requested(0)
+  {}
+
+  virtual void make_room(RuleSet& rules, unsigned int count) const
+  {
+    requested += count;
+  }
+
+  mutable unsigned int requested;
+};
+
+
+TEST(OneRuleAgent, test_make_room_only_to_cover)
+{
+  RoomRecorder recorder;
+  recorder.define(Rule({Interval(0, 50)}, predictions), Performance(1.0, 1.0, 1.0));
+  Agent covering_agent(recorder, *covering, *reward);
+
+  covering_agent.predict(Vector({ 25 }));
+  CHECK_EQUAL(0, recorder.requested);
+
+  covering_agent.predict(Vector({ 75 }));
+  CHECK_EQUAL(covering->strength(), recorder.requested);
+}
+
+
+
 TEST_GROUP(TwoRulesAgent)
 {
   Covering *covering;
@@ -95,13 +130,11 @@ TEST_GROUP(TwoRulesAgent)
     covering = new FakeCovering();
     reward = new WilsonReward(0.25, 500, 2);
 
-    rule_1 = new MetaRule(Rule({Interval(0, 49)}, { 4 }),
-			  Performance(1.0, 1.0, 1.0));
-    evolution.define(*rule_1);
+    rule_1 = evolution.define(Rule({Interval(0, 49)}, { 4 }),
+			      Performance(1.0, 1.0, 1.0));
 
-    rule_2 = new MetaRule(Rule({Interval(40, 100)}, { 3 }),
-			  Performance(1.0, 1.0, 1.0));
-    evolution.define(*rule_2);
+    rule_2 = evolution.define(Rule({Interval(40, 100)}, { 3 }),
+			      Performance(1.0, 1.0, 1.0));
 
     agent = new Agent(evolution, *covering, *reward);
   }
@@ -155,15 +188,12 @@ TEST_GROUP(OverlappingRulesAgent)
   {
     covering = new FakeCovering();
     reward   = new WilsonReward(0.25, 500, 2);
-    rule_1   = new MetaRule(Rule({Interval(0, 100)}, { 4 }),
-			  Performance(1.0, 1.0, 1.0));
-    rule_2   = new MetaRule(Rule({Interval(0, 100)}, { 4 }),
-			  Performance(0.8, 0.8, 1.0));
-    rule_3   = new MetaRule(Rule({Interval(0, 100)}, { 3 }),
-			  Performance(0.5, 0.5, 1.0));
-    evolution.define(*rule_1);
-    evolution.define(*rule_2);
-    evolution.define(*rule_3);
+    rule_1   = evolution.define(Rule({Interval(0, 100)}, { 4 }),
+				Performance(1.0, 1.0, 1.0));
+    rule_2   = evolution.define(Rule({Interval(0, 100)}, { 4 }),
+				Performance(0.8, 0.8, 1.0));
+    rule_3   = evolution.define(Rule({Interval(0, 100)}, { 3 }),
+				Performance(0.5, 0.5, 1.0));
     agent    = new Agent(evolution, *covering, *reward);
   }
 
@@ -198,6 +228,104 @@ TEST(OverlappingRulesAgent, test_reward)
 
 
 
+TEST_GROUP(TicketedAgent)
+{
+  Covering		*covering;
+  RewardFunction	*reward;
+  TestRuleFactory	 evolution;
+  Agent			*agent;
+  MetaRule		*rule_1, *rule_2;
+
+  void setup(void)
+  {
+    covering = new FakeCovering();
+    reward   = new WilsonReward(0.25, 500, 2);
+    rule_1   = evolution.define(Rule({Interval(0, 49)}, { 4 }),
+				Performance(1.0, 1.0, 1.0));
+    rule_2   = evolution.define(Rule({Interval(40, 100)}, { 3 }),
+				Performance(1.0, 1.0, 1.0));
+    agent    = new Agent(evolution, *covering, *reward, 2);
+  }
+
+  void teardown(void)
+  {
+    delete agent;
+    delete covering;
+    delete reward;
+  }
+
+};
+
+
+TEST(TicketedAgent, test_tickets_follow_predictions)
+{
+  agent->predict(Vector({ 25 }));
+  CHECK_EQUAL(0UL, agent->ticket());
+
+  agent->predict(Vector({ 75 }));
+  CHECK_EQUAL(1UL, agent->ticket());
+}
+
+
+TEST(TicketedAgent, test_reward_an_earlier_prediction)
+{
+  agent->predict(Vector({ 25 }));
+  const Ticket first = agent->ticket();
+  agent->predict(Vector({ 75 }));
+
+  CHECK(agent->reward(first, 10));
+
+  DOUBLES_EQUAL(3.25, rule_1->weighted_payoff(), 1e-6);
+  DOUBLES_EQUAL(1.0, rule_2->weighted_payoff(), 1e-6);
+}
+
+
+TEST(TicketedAgent, test_reject_rewards_twice)
+{
+  agent->predict(Vector({ 25 }));
+
+  CHECK(agent->reward(agent->ticket(), 10));
+  CHECK_FALSE(agent->reward(agent->ticket(), 10));
+
+  DOUBLES_EQUAL(3.25, rule_1->weighted_payoff(), 1e-6);
+}
+
+
+TEST(TicketedAgent, test_reject_tickets_out_of_the_window)
+{
+  agent->predict(Vector({ 25 }));
+  const Ticket first = agent->ticket();
+  agent->predict(Vector({ 75 }));
+  agent->predict(Vector({ 75 }));
+
+  CHECK_FALSE(agent->reward(first, 10));
+  CHECK_FALSE(agent->reward(first + 5, 10));
+
+  DOUBLES_EQUAL(1.0, rule_1->weighted_payoff(), 1e-6);
+}
+
+
+TEST(TicketedAgent, test_skip_rules_released_before_the_reward)
+{
+  agent->predict(Vector({ 25 }));
+  const Ticket ticket = agent->ticket();
+  MetaRulePool& pool = rule_1->pool();
+  pool.release(rule_1);
+  MetaRule* newcomer = pool.acquire(Rule({Interval(0, 49)}, { 4 }),
+				    Performance(1.0, 1.0, 1.0));
+
+  CHECK(agent->reward(ticket, 10));
+
+  DOUBLES_EQUAL(1.0, newcomer->weighted_payoff(), 1e-6);
+}
+
+
+TEST(TicketedAgent, test_reject_empty_windows)
+{
+  CHECK_THROWS(std::invalid_argument, Agent(evolution, *covering, *reward, 0));
+}
+
+
 TEST_GROUP(TestAgentEvolution)
 {
   MetaRulePool		 pool;
@@ -205,6 +333,7 @@ TEST_GROUP(TestAgentEvolution)
   Randomizer		 randomizer;
   Decision		*decisions;
   Selection		*selection;
+  Deletion		*deletion;
   Crossover		*crossover;
   AlleleMutation	*mutation;
   DefaultEvolution	*evolution;
@@ -218,6 +347,7 @@ TEST_GROUP(TestAgentEvolution)
     reward    = new WilsonReward(0.25, 500, 2);
     decisions = new RandomDecision(randomizer, 0.25, 0.1);
     selection = new RouletteWheel(randomizer);
+    deletion  = new WorstDeletion();
     crossover = new TwoPointCrossover(randomizer);
     mutation  = new RandomAlleleMutation(randomizer);
     listener  = new LogListener(cout);
@@ -227,6 +357,7 @@ TEST_GROUP(TestAgentEvolution)
 				     *decisions,
 				     *crossover,
 				     *selection,
+				     *deletion,
 				     *mutation,
 				     *listener);
     covering  = new FakeCovering();
@@ -238,6 +369,7 @@ TEST_GROUP(TestAgentEvolution)
     delete codec;
     delete decisions;
     delete selection;
+    delete deletion;
     delete crossover;
     delete mutation;
     delete listener;
@@ -271,3 +403,60 @@ IGNORE_TEST(TestAgentEvolution, test_long_run)
     }
   }
 }
+
+
+
+TEST_GROUP(TestAgentAllocations)
+{
+  Covering		*covering;
+  RewardFunction	*reward;
+  TestRuleFactory	 evolution;
+  Agent			*agent;
+
+  void setup(void)
+  {
+    covering = new FakeCovering();
+    reward   = new WilsonReward(0.25, 500, 2);
+    evolution.define(Rule({Interval(0, 60)}, { 4 }), Performance(1.0, 1.0, 1.0));
+    evolution.define(Rule({Interval(20, 80)}, { 4 }), Performance(0.8, 0.8, 1.0));
+    evolution.define(Rule({Interval(40, 100)}, { 3 }), Performance(0.5, 0.5, 1.0));
+    evolution.define(Rule({Interval(0, 100)}, { 7 }), Performance(0.2, 0.2, 1.0));
+    agent    = new Agent(evolution, *covering, *reward);
+  }
+
+  void teardown(void)
+  {
+    delete agent;
+    delete covering;
+    delete reward;
+  }
+
+  void predict_and_reward_all_inputs(void)
+  {
+    for (int value=0 ; value<=100 ; ++value) {
+      const Vector& prediction = agent->predict(Vector({ value }));
+      agent->reward(prediction[0] == Value(4) ? 100 : 10);
+    }
+  }
+
+};
+
+
+TEST(TestAgentAllocations, test_no_allocation_after_warm_up)
+{
+  predict_and_reward_all_inputs();
+
+  // Inputs are built before counting: only predict and reward are measured
+  vector<Vector> inputs;
+  for (int value=0 ; value<=100 ; ++value) {
+    inputs.push_back(Vector({ value }));
+  }
+
+  AllocationCounter allocations;
+  for (auto& each_input: inputs) {
+    agent->predict(each_input);
+    agent->reward(50);
+  }
+
+  CHECK_EQUAL(0UL, allocations.count());
+}
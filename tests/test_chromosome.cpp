@@ -41,3 +41,43 @@ TEST(TestChromosome, test_debug_formatting)
 
   CHECK_EQUAL("{ 12, 20, 30 }", out.str());
 }
+
+
+
+TEST_GROUP(TestCodec)
+{
+  MetaRulePool pool { Dimensions(2, 1) };
+  Codec codec { pool };
+};
+
+
+TEST(TestCodec, test_encoding)
+{
+  MetaRule* rule = pool.acquire(Rule({ Interval(10, 20), Interval(30, 40) }, { 50 }));
+
+  CHECK(Chromosome({ 10, 20, 30, 40, 50 }) == codec.encode(*rule));
+}
+
+
+TEST(TestCodec, test_encoding_reuses_the_genome)
+{
+  MetaRule* rule = pool.acquire(Rule({ Interval(10, 20), Interval(30, 40) }, { 50 }));
+  Chromosome genome;
+  genome.reserve(8);
+  const Allele* storage = genome.data();
+
+  codec.encode(*rule, genome);
+
+  CHECK(Chromosome({ 10, 20, 30, 40, 50 }) == genome);
+  CHECK(storage == genome.data());
+}
+
+
+TEST(TestCodec, test_round_trip)
+{
+  MetaRule* rule = pool.acquire(Rule({ Interval(10, 20), Interval(30, 40) }, { 50 }));
+
+  MetaRule* copy = codec.decode(pool.dimensions(), codec.encode(*rule), Performance(0, 0, 0));
+
+  CHECK(pool.same_content(rule->slot(), copy->slot()));
+}
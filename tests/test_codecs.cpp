@@ -20,10 +20,13 @@
 #include "CppUTest/TestHarness.h"
 #include "CppUTestExt/MockSupport.h"
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 
+#include "application.h"
 #include "context.h"
 #include "controller.h"
 
@@ -46,6 +49,15 @@ class TestController: public Controller
       .withParameter("value", value);
   }
 
+  virtual void reward(Ticket ticket, double value)
+  {
+    mock()
+      .actualCall("ticketed_reward")
+      .onObject(this)
+      .withParameter("ticket", ticket)
+      .withParameter("value", value);
+  }
+
   virtual void predict(const Vector& context)
   {
     mock()
@@ -60,6 +72,25 @@ class TestController: public Controller
       actualCall("show");
   }
 
+  virtual void predict_all(const std::vector<Vector>& contexts)
+  {
+    mock()
+      .actualCall("predict_all")
+      .onObject(this)
+      .withParameter("count", static_cast<unsigned int>(contexts.size()))
+      .withParameterOfType("Vector", "last", (void*) &contexts.back());
+  }
+
+  virtual void reward_all(Ticket first, const std::vector<double>& values)
+  {
+    mock()
+      .actualCall("reward_all")
+      .onObject(this)
+      .withParameter("first", first)
+      .withParameter("count", static_cast<unsigned int>(values.size()))
+      .withParameter("last", values.back());
+  }
+
 };
 
 
@@ -150,6 +181,22 @@ TEST(TestReader, test_reading_another_reward)
 }
 
 
+TEST(TestReader, test_reading_ticketed_reward)
+{
+  mock().expectNCalls(0, "reward");
+  mock()
+    .expectOneCall("ticketed_reward")
+    .onObject(target)
+    .withParameter("ticket", 3UL)
+    .withParameter("value", 12.5);
+
+  input << "R:3:12.5" << endl;
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
 TEST(TestReader, test_reading_invalid_reward)
 {
   mock().expectNCalls(0, "reward");
@@ -177,6 +224,260 @@ TEST(TestReader, test_reading_input)
 
 
 
+TEST(TestReader, test_reading_batch_of_inputs)
+{
+  Vector last = { 5, 6 };
+  mock()
+    .expectOneCall("predict_all")
+    .onObject(target)
+    .withParameter("count", 3U)
+    .withParameterOfType("Vector", "last", &last);
+
+  input << "BP:(1, 2);(3, 4);(5, 6)" << endl;
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestReader, test_reading_batch_of_rewards)
+{
+  mock()
+    .expectOneCall("reward_all")
+    .onObject(target)
+    .withParameter("first", 7UL)
+    .withParameter("count", 3U)
+    .withParameter("last", 30.5);
+
+  input << "BR:7:10;20;30.5" << endl;
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestReader, test_reading_empty_batch_of_inputs)
+{
+  mock().expectNCalls(0, "predict_all");
+
+  input << "BP:" << endl;
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestReader, test_reading_batch_of_inputs_with_trailing_separator)
+{
+  mock().expectNCalls(0, "predict_all");
+
+  input << "BP:(1,2);" << endl;
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestReader, test_reading_batch_of_rewards_with_empty_item)
+{
+  mock().expectNCalls(0, "reward_all");
+
+  input << "BR:7:10;;30.5" << endl;
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestReader, test_reading_batch_of_rewards_without_ticket)
+{
+  mock().expectNCalls(0, "reward_all");
+
+  input << "BR:10;20;30.5" << endl;
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+string
+binary_frame(char command, const string& payload)
+{
+  string result(1, command);
+  for (unsigned int index=0 ; index<4 ; ++index) {
+    result.push_back(static_cast<char>((payload.size() >> (8 * index)) & 0xFF));
+  }
+  return result + payload;
+}
+
+
+string
+little_endian(std::uint64_t value, unsigned int size)
+{
+  string result;
+  for (unsigned int index=0 ; index<size ; ++index) {
+    result.push_back(static_cast<char>((value >> (8 * index)) & 0xFF));
+  }
+  return result;
+}
+
+
+string
+little_endian(double value)
+{
+  std::uint64_t bits;
+  memcpy(&bits, &value, sizeof(value));
+  return little_endian(bits, 8);
+}
+
+
+TEST_GROUP(TestBinaryReader)
+{
+  VectorComparator comparator;
+  stringstream input;
+  stringstream replies;
+  Controller *target;
+  Decoder *reader;
+
+  void setup(void) {
+    mock().installComparator("Vector", comparator);
+
+    target = new TestController();
+    reader = new BinaryDecoder(input, *target, replies);
+  }
+
+  void teardown(void) {
+    delete target;
+    delete reader;
+    mock().removeAllComparators();
+    mock().clear();
+  }
+
+};
+
+
+TEST(TestBinaryReader, test_reading_input)
+{
+  Vector expected = { 10, 20, 30 };
+  mock()
+    .expectOneCall("predict")
+    .onObject(target)
+    .withParameterOfType("Vector", "context", &expected);
+
+  input << binary_frame('P', little_endian(10, 2) + little_endian(20, 2) + little_endian(30, 2));
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_reward)
+{
+  mock().expectOneCall("reward").onObject(target).withParameter("value", 23.5);
+
+  input << binary_frame('R', little_endian(23.5));
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_ticketed_reward)
+{
+  mock().expectNCalls(0, "reward");
+  mock()
+    .expectOneCall("ticketed_reward")
+    .onObject(target)
+    .withParameter("ticket", 300UL)
+    .withParameter("value", 12.5);
+
+  input << binary_frame('R', little_endian(300, 8) + little_endian(12.5));
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_show)
+{
+  mock().expectOneCall("show");
+
+  input << binary_frame('S', "");
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_several_frames)
+{
+  mock().expectNCalls(2, "show");
+  mock().expectOneCall("reward").onObject(target).withParameter("value", 1.0);
+
+  input << binary_frame('S', "") << binary_frame('R', little_endian(1.0)) << binary_frame('S', "");
+  reader->decode();
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_invalid_command)
+{
+  mock().expectNCalls(0, "show");
+
+  input << binary_frame('X', "");
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_batch)
+{
+  mock().expectNCalls(0, "predict_all");
+  mock().expectNCalls(0, "predict");
+
+  input << binary_frame('B', little_endian(10, 2));
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_invalid_reward)
+{
+  mock().expectNCalls(0, "reward");
+
+  input << binary_frame('R', little_endian(15, 4));
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_truncated_frame)
+{
+  mock().expectNCalls(0, "predict");
+
+  input << binary_frame('P', little_endian(10, 2) + little_endian(20, 2)).substr(0, 7);
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+TEST(TestBinaryReader, test_reading_out_of_range_input)
+{
+  mock().expectNCalls(0, "predict");
+
+  input << binary_frame('P', little_endian(Value::MAXIMUM + 1, 2));
+  CHECK_THROWS(std::invalid_argument, {reader->decode();});
+
+  mock().checkExpectations();
+}
+
+
+
 TEST_GROUP(TestEncoder)
 {
   stringstream text;
@@ -203,6 +504,16 @@ TEST(TestEncoder, test_show_prediction)
 }
 
 
+TEST(TestEncoder, test_show_predictions)
+{
+  vector<Vector> predictions = { Vector({ 10, 20 }), Vector({ 30 }) };
+
+  encoder->show_predictions(predictions);
+
+  CHECK(text.str() == "[10, 20];[30]\n");
+}
+
+
 TEST(TestEncoder, test_show_agent)
 {
   WilsonReward reward(0.25, 500, 2);
@@ -216,3 +527,139 @@ TEST(TestEncoder, test_show_agent)
   agent.display_on(expected);
   CHECK(text.str() == expected.str());
 }
+
+
+
+TEST_GROUP(TestBinaryEncoder)
+{
+  stringstream bytes;
+  Encoder *encoder;
+
+  void setup(void) {
+    encoder = new BinaryEncoder(bytes);
+  }
+
+  void teardown(void) {
+    delete encoder;
+  }
+
+};
+
+
+TEST(TestBinaryEncoder, test_show_prediction)
+{
+  Vector prediction = { 10, 20, 30 };
+
+  encoder->show_prediction(prediction);
+
+  const string expected = binary_frame('P', little_endian(10, 2) + little_endian(20, 2) + little_endian(30, 2));
+  CHECK(bytes.str() == expected);
+}
+
+
+TEST(TestBinaryEncoder, test_show_agent)
+{
+  WilsonReward reward(0.25, 500, 2);
+  TestRuleFactory factory;
+  FakeCovering covering;
+  Agent agent(factory, covering, reward);
+
+  encoder->show(agent);
+
+  stringstream text;
+  agent.display_on(text);
+  CHECK(bytes.str() == binary_frame('S', text.str()));
+}
+
+
+
+TEST_GROUP(TestAgentController)
+{
+  stringstream		 replies;
+  Encoder		*encoder;
+  WilsonReward		*reward;
+  FakeCovering		 covering;
+  TestRuleFactory	 evolution;
+  MetaRule		*rule_1, *rule_2;
+  AgentController	*controller;
+
+  void setup(void) {
+    encoder    = new Encoder(replies);
+    reward     = new WilsonReward(0.25, 500, 2);
+    rule_1     = evolution.define(Rule({Interval(0, 49)}, { 4 }),
+				  Performance(1.0, 1.0, 1.0));
+    rule_2     = evolution.define(Rule({Interval(40, 100)}, { 3 }),
+				  Performance(1.0, 1.0, 1.0));
+    controller = new AgentController(*encoder, evolution, covering, *reward);
+  }
+
+  void teardown(void) {
+    delete controller;
+    delete reward;
+    delete encoder;
+  }
+
+};
+
+
+TEST(TestAgentController, test_predict_a_batch)
+{
+  controller->predict_all({ Vector({ 25 }), Vector({ 75 }), Vector({ 10 }) });
+
+  CHECK(replies.str() == "[4];[3];[4]\n");
+}
+
+
+TEST(TestAgentController, test_reward_a_batch)
+{
+  controller->predict_all({ Vector({ 25 }), Vector({ 75 }) });
+  controller->reward_all(0, { 10, 20 });
+
+  DOUBLES_EQUAL(3.25, rule_1->weighted_payoff(), 1e-6);
+  DOUBLES_EQUAL(5.75, rule_2->weighted_payoff(), 1e-6);
+}
+
+
+
+TEST_GROUP(TestApplication)
+{
+  stringstream		 input;
+  stringstream		 output;
+  WilsonReward		*reward;
+  FakeCovering		 covering;
+  TestRuleFactory	 evolution;
+
+  void setup(void) {
+    reward = new WilsonReward(0.25, 500, 2);
+    evolution.define(Rule({Interval(0, 49)}, { 4 }), Performance(1.0, 1.0, 1.0));
+  }
+
+  void teardown(void) {
+    delete reward;
+  }
+
+};
+
+
+TEST(TestApplication, test_text_replies_follow_the_banner)
+{
+  Application application(input, output, evolution, covering, *reward);
+
+  input << "P:(25)" << endl;
+  application.run();
+
+  stringstream expected;
+  expected << APPLICATION << " v" << VERSION << endl << "[4]" << endl;
+  CHECK(output.str() == expected.str());
+}
+
+
+TEST(TestApplication, test_binary_replies_start_with_a_frame)
+{
+  Application application(input, output, evolution, covering, *reward, Protocol::BINARY);
+
+  input << binary_frame(frame::PREDICT, little_endian(25, 2));
+  application.run();
+
+  CHECK(output.str() == binary_frame(frame::PREDICT, little_endian(4, 2)));
+}
@@ -1,8 +1,13 @@
 #include "CppUTest/TestHarness.h"
 
 
+#include <utility>
+#include <vector>
+
 #include "context.h"
 
+#include "helpers.h"
+
 
 using namespace xcsf;
 
@@ -26,6 +31,58 @@ TEST(TestVector, test_parsing_signle_value_sequence)
 }
 
 
+TEST(TestVector, test_copy_beyond_inline_capacity)
+{
+  std::vector<unsigned int> values;
+  for (unsigned int index=0 ; index<2 * Vector::INLINE_CAPACITY ; ++index) {
+    values.push_back(index);
+  }
+  Vector original(values);
+
+  Vector copy(original);
+
+  CHECK_EQUAL(2 * Vector::INLINE_CAPACITY, copy.size());
+  CHECK(original == copy);
+}
+
+
+TEST(TestVector, test_assign_a_vector_of_another_size)
+{
+  std::vector<unsigned int> values(Vector::INLINE_CAPACITY + 1, 7);
+  Vector actual = { 1, 2 };
+
+  actual = Vector(values);
+  CHECK(Vector(values) == actual);
+
+  actual = Vector({ 3 });
+  CHECK(Vector({ 3 }) == actual);
+}
+
+
+TEST(TestVector, test_move_leaves_an_empty_vector)
+{
+  std::vector<unsigned int> values(Vector::INLINE_CAPACITY + 1, 7);
+  Vector original(values);
+
+  Vector moved(std::move(original));
+
+  CHECK(Vector(values) == moved);
+  CHECK_EQUAL(0, original.size());
+}
+
+
+TEST(TestVector, test_no_allocation_within_inline_capacity)
+{
+  Vector original = { 1, 2, 3, 4 };
+
+  AllocationCounter allocations;
+  Vector copy(original);
+  copy = original;
+
+  CHECK_EQUAL(0UL, allocations.count());
+}
+
+
 
 
 TEST_GROUP(TestValue)
@@ -84,9 +141,9 @@ TEST(TestValue, test_addition) {
 };
 
 TEST(TestValue, test_addition_with_overflow) {
-  Value v1(90);
-  Value v2(90);
-  CHECK(100 == v1 + v2);
+  Value v1(Value::MAXIMUM - 10);
+  Value v2(Value::MAXIMUM - 10);
+  CHECK(Value(Value::MAXIMUM) == v1 + v2);
 };
 
 TEST(TestValue, test_subtraction) {
@@ -102,7 +159,12 @@ TEST(TestValue, test_subtraction_with_underflow) {
 };
 
 
+TEST(TestValue, test_unchecked_construction) {
+  CHECK(Value(42) == Value::unchecked(42));
+}
+
+
 TEST(TestValue, test_invalid_values)
 {
-   CHECK_THROWS(std::invalid_argument, {Value value(150);});
+   CHECK_THROWS(std::invalid_argument, {Value value(Value::MAXIMUM + 50);});
 }
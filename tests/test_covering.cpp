@@ -55,6 +55,21 @@ TEST(TestCovering, test_covering)
   Vector context = { 6 };
   (*cover)(rules, context);
 
-  CHECK_EQUAL(strength, rules.size());
+  unsigned int numerosity = 0;
+  for (unsigned int index=0 ; index<rules.size() ; ++index) {
+    numerosity += rules[index].numerosity();
+  }
+  CHECK_EQUAL(strength, numerosity);
+}
+
+
+TEST(TestCovering, test_identical_rules_are_merged)
+{
+  Vector context = { 6 };
+  (*cover)(rules, context);
+
+  CHECK_EQUAL(1, rules.size());
+  CHECK_EQUAL(strength, rules[0].numerosity());
+  CHECK_EQUAL(1, pool.active_rule_count());
 }
 
@@ -24,6 +24,7 @@
 #include "evolution.h"
 
 #include <iostream>
+#include <set>
 #include <sstream>
 
 
@@ -54,7 +55,7 @@ TEST_GROUP(TestCrossover)
 
 TEST(TestCrossover, cut_in_the_middle)
 {
-  randomizer->sequence({ 0.6, 0.5 });
+  randomizer->sequence({ 0.6, 0.0 });
   
   vector<Chromosome> children;
   (*crossover)(father, mother, children);
@@ -190,3 +191,159 @@ TEST(TestCrossoverWithInvalidRules, test_empty_parent)
     
   CHECK_THROWS(invalid_argument,{ crossover(father, other, children); });
 }
+
+
+TEST_GROUP(TestCrossoverOperators)
+{
+  Chromosome father = { 10, 20, 30, 40, 50 };
+  Chromosome mother = { 60, 70, 80, 90, 95 };
+  Chromosome son = Chromosome(5);
+  Chromosome daughter = Chromosome(5);
+
+  TestableRandomizer randomizer = TestableRandomizer({ 0.5 });
+
+  template <class Operator>
+  void cross(const Operator& cross)
+  {
+    cross(father.data(), mother.data(), son.data(), daughter.data(), father.size());
+  }
+
+};
+
+
+TEST(TestCrossoverOperators, test_one_point)
+{
+  randomizer.sequence({ 0.5 });
+
+  cross(OnePointOperator(randomizer));
+
+  CHECK(Chromosome({ 10, 20, 80, 90, 95 }) == son);
+  CHECK(Chromosome({ 60, 70, 30, 40, 50 }) == daughter);
+}
+
+
+TEST(TestCrossoverOperators, test_two_points)
+{
+  randomizer.sequence({ 0.25, 0.3 });
+
+  cross(TwoPointOperator(randomizer));
+
+  CHECK(Chromosome({ 10, 70, 80, 40, 50 }) == son);
+  CHECK(Chromosome({ 60, 20, 30, 90, 95 }) == daughter);
+}
+
+
+TEST(TestCrossoverOperators, test_one_point_may_cut_anywhere)
+{
+  for (Locus cut=0 ; cut<father.size() ; ++cut) {
+    randomizer.sequence({ (cut + 0.5) / father.size() });
+
+    cross(OnePointOperator(randomizer));
+
+    for (Locus locus=0 ; locus<son.size() ; ++locus) {
+      CHECK(son[locus] == (locus < cut ? father[locus] : mother[locus]));
+    }
+  }
+}
+
+
+TEST(TestCrossoverOperators, test_two_points_may_reach_the_last_locus)
+{
+  randomizer.sequence({ 0.99, 0.99 });
+
+  cross(TwoPointOperator(randomizer));
+
+  CHECK(Chromosome({ 10, 20, 30, 40, 95 }) == son);
+  CHECK(Chromosome({ 60, 70, 80, 90, 50 }) == daughter);
+}
+
+
+TEST(TestCrossoverOperators, test_uniform)
+{
+  randomizer.sequence({ 10.5 / 4294967295. });
+
+  cross(UniformOperator(randomizer));
+
+  CHECK(Chromosome({ 10, 70, 30, 90, 50 }) == son);
+  CHECK(Chromosome({ 60, 20, 80, 40, 95 }) == daughter);
+}
+
+
+TEST(TestCrossoverOperators, test_intervals_are_never_split)
+{
+  randomizer.sequence({ 0., 0. });
+
+  cross(IntervalOperator(randomizer, 2));
+
+  CHECK(Chromosome({ 60, 70, 30, 40, 50 }) == son);
+  CHECK(Chromosome({ 10, 20, 80, 90, 95 }) == daughter);
+}
+
+
+TEST(TestCrossoverOperators, test_breed_pairs)
+{
+  randomizer.sequence({ 0. });
+  Chromosome parents = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  Chromosome children(8);
+
+  breed_pairs(OnePointOperator(randomizer), parents.data(), children.data(), 2, 2);
+
+  CHECK(Chromosome({ 3, 4, 1, 2, 7, 8, 5, 6 }) == children);
+}
+
+
+TEST(TestCrossoverOperators, test_static_crossover)
+{
+  randomizer.sequence({ 0.25, 0.3 });
+  StaticCrossover<TwoPointOperator> crossover(randomizer);
+  vector<Chromosome> children;
+
+  crossover(father, mother, children);
+
+  CHECK_EQUAL(2, children.size());
+  CHECK(Chromosome({ 10, 70, 80, 40, 50 }) == children[0]);
+  CHECK(Chromosome({ 60, 20, 30, 90, 95 }) == children[1]);
+}
+
+
+TEST(TestCrossoverOperators, test_static_crossover_validates_parents)
+{
+  StaticCrossover<UniformOperator> crossover(randomizer);
+  Chromosome other = { 1, 2 };
+  vector<Chromosome> children;
+
+  CHECK_THROWS(invalid_argument, { crossover(father, other, children); });
+}
+
+
+TEST(TestCrossoverOperators, test_intervals_may_cut_before_the_conclusions)
+{
+  randomizer.sequence({ 0.99, 0.99 });
+
+  cross(IntervalOperator(randomizer, 2));
+
+  CHECK(Chromosome({ 10, 20, 30, 40, 95 }) == son);
+  CHECK(Chromosome({ 60, 70, 80, 90, 50 }) == daughter);
+}
+
+
+TEST(TestCrossoverOperators, test_every_gene_segment_occurs)
+{
+  // One input and one output: the interval, the conclusion or both
+  Chromosome short_father = { 10, 20, 30 };
+  Chromosome short_mother = { 60, 70, 80 };
+  Chromosome short_son(3), short_daughter(3);
+  Randomizer generate(42);
+  IntervalOperator cross(generate, 1);
+
+  std::set<Chromosome> sons;
+  for (unsigned int draw=0 ; draw<100 ; ++draw) {
+    cross(short_father.data(), short_mother.data(),
+	  short_son.data(), short_daughter.data(), short_son.size());
+    sons.insert(short_son);
+  }
+
+  CHECK(sons == std::set<Chromosome>({ Chromosome({ 60, 70, 30 }),
+				       Chromosome({ 10, 20, 80 }),
+				       Chromosome({ 60, 70, 80 }) }));
+}
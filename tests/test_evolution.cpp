@@ -85,6 +85,37 @@ TEST(TestRandomDecision, test_shall_not_mutate)
 }
 
 
+TEST(TestRandomDecision, test_skipped_loci)
+{
+  RandomDecision fair(*randomizer, evolution, 0.5);
+
+  randomizer->sequence({ 0.25, 1., 0.0001 });
+  CHECK_EQUAL(2, fair.skipped_loci(10));
+  CHECK_EQUAL(0, fair.skipped_loci(10));
+  CHECK_EQUAL(10, fair.skipped_loci(10));
+}
+
+
+TEST(TestRandomDecision, test_skipped_loci_at_extreme_probabilities)
+{
+  RandomDecision never(*randomizer, evolution, 0.);
+  RandomDecision always(*randomizer, evolution, 1.);
+
+  CHECK_EQUAL(7, never.skipped_loci(7));
+  CHECK_EQUAL(0, always.skipped_loci(7));
+}
+
+
+TEST(TestRandomDecision, test_skipped_loci_by_coin_flips)
+{
+  FixedDecision never(EVOLUTION, NO_MUTATION);
+  FixedDecision always(EVOLUTION, MUTATION);
+
+  CHECK_EQUAL(7, never.skipped_loci(7));
+  CHECK_EQUAL(0, always.skipped_loci(7));
+}
+
+
 class FakeCrossover: public Crossover
 {
 public:
@@ -122,13 +153,13 @@ public:
 
   virtual ~FakeAlleleMutation(){};
 
-  virtual void operator () (Chromosome& subject, const Allele& target) const
+  virtual void operator () (Chromosome& subject, const Locus& target) const
   {
     subject[target] = _mutated;
   };
 
 private:
-  const Allele& _mutated;
+  const Allele _mutated;
 
 };
 
@@ -157,7 +188,7 @@ public:
     mock().actualCall("on_breeding");
   };
 
-  virtual void on_mutation(const Chromosome& subject, const Allele& locus) const
+  virtual void on_mutation(const Chromosome& subject, const Locus& locus) const
   {
     mock().actualCall("on_mutation");
   };
@@ -166,6 +197,54 @@ public:
 };
 
 
+TEST_GROUP(TestMutationEngine)
+{
+  TestableRandomizer	 randomizer = TestableRandomizer({ 0.25 });
+  RandomDecision	 decision   = RandomDecision(randomizer, 1., 0.5);
+  FakeAlleleMutation	 mutation   = FakeAlleleMutation(77);
+  vector<Chromosome>	 subjects   = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+  vector<Mutation>	 mutations;
+};
+
+
+TEST(TestMutationEngine, test_mutations_span_chromosomes)
+{
+  MutationEngine mutate(decision, mutation);
+
+  mutate(subjects, 0, mutations);
+
+  vector<Mutation> expected = { Mutation(0, 2), Mutation(1, 2), Mutation(2, 2) };
+  CHECK(expected == mutations);
+  CHECK(Chromosome({ 1, 2, 77 }) == subjects[0]);
+  CHECK(Chromosome({ 4, 5, 77 }) == subjects[1]);
+  CHECK(Chromosome({ 7, 8, 77 }) == subjects[2]);
+}
+
+
+TEST(TestMutationEngine, test_earlier_chromosomes_are_left_intact)
+{
+  randomizer.sequence({ 0.5 });
+  MutationEngine mutate(decision, mutation);
+
+  mutate(subjects, 1, mutations);
+
+  vector<Mutation> expected = { Mutation(1, 1), Mutation(2, 0), Mutation(2, 2) };
+  CHECK(expected == mutations);
+  CHECK(Chromosome({ 1, 2, 3 }) == subjects[0]);
+}
+
+
+TEST(TestMutationEngine, test_no_mutation)
+{
+  FixedDecision never(EVOLUTION, NO_MUTATION);
+  MutationEngine mutate(never, mutation);
+
+  mutate(subjects, 0, mutations);
+
+  CHECK(mutations.empty());
+}
+
+
 TEST_GROUP(TestDefaultEvolution)
 {
   MetaRulePool		 pool;
@@ -175,6 +254,7 @@ TEST_GROUP(TestDefaultEvolution)
   AlleleMutation	*mutations;
   Crossover		*crossover;
   Selection		*selection;
+  Deletion		*deletion;
   EvolutionListener	*listener;
   Codec			*codec;
 
@@ -189,6 +269,7 @@ TEST_GROUP(TestDefaultEvolution)
     rules->add(*rule_1);
     rules->add(*rule_2);
     selection = new DummySelection();
+    deletion  = new WorstDeletion();
     mutations = new FakeAlleleMutation(77);
     listener  = new FakeListener();
     codec     = new Codec(pool);
@@ -200,6 +281,7 @@ TEST_GROUP(TestDefaultEvolution)
     delete rules;
     delete crossover;
     delete selection;
+    delete deletion;
     delete mutations;
     delete listener;
     mock().clear();
@@ -219,6 +301,7 @@ TEST(TestDefaultEvolution, test_no_evolution)
 			     decision,
 			     *crossover,
 			     *selection,
+			     *deletion,
 			     *mutations,
 			     *listener);
 
@@ -241,6 +324,7 @@ TEST(TestDefaultEvolution, test_evolution_without_mutation)
 			     decision,
 			     *crossover,
 			     *selection,
+			     *deletion,
 			     *mutations,
 			     *listener);
 
@@ -268,6 +352,7 @@ TEST(TestDefaultEvolution, test_evolution_with_mutation)
 			     decision,
 			     *crossover,
 			     *selection,
+			     *deletion,
 			     *mutations,
 			     *listener);
 
@@ -283,6 +368,37 @@ TEST(TestDefaultEvolution, test_evolution_with_mutation)
 }
 
 
+TEST(TestDefaultEvolution, test_children_subsumed_by_any_accurate_rule)
+{
+  MetaRule* subsumer = pool.acquire(Rule({Interval(0, 50)}, { 20 }),
+				    Performance(1.0, 1.0, 0.0));
+  for (unsigned int step=0 ; step<=Subsumption::DEFAULT_EXPERIENCE ; ++step) {
+    pool.add_experience(subsumer->slot());
+  }
+  rules->add(*subsumer);
+
+  NoListener quiet;
+  FixedDecision decision(EVOLUTION, NO_MUTATION);
+  DefaultEvolution evolution(pool,
+			     *codec,
+			     decision,
+			     *crossover,
+			     *selection,
+			     *deletion,
+			     *mutations,
+			     quiet);
+  Subsumption subsumption(1.0);
+  evolution.subsume_with(&subsumption);
+
+  evolution.evolve(*rules);
+
+  // The parents, the first two rules, could not subsume the child
+  CHECK_EQUAL(3, rules->size());
+  CHECK_EQUAL(2, subsumer->numerosity());
+  CHECK_EQUAL(3, pool.active_rule_count());
+}
+
+
 TEST(TestDefaultEvolution, test_listening)
 {
   mock().expectOneCall("on_rule_added");
@@ -296,6 +412,7 @@ TEST(TestDefaultEvolution, test_listening)
 			     decision,
 			     *crossover,
 			     *selection,
+			     *deletion,
 			     *mutations,
 			     *listener);
 
@@ -315,6 +432,7 @@ TEST_GROUP(TestDefaultEvolutionAtCapacity)
   AlleleMutation	*mutations;
   Crossover		*crossover;
   Selection		*selection;
+  Deletion		*deletion;
   EvolutionListener	*listener;
   Codec			*codec;
 
@@ -333,6 +451,7 @@ TEST_GROUP(TestDefaultEvolutionAtCapacity)
 
     crossover = new FakeCrossover(child);
     selection = new DummySelection();
+    deletion  = new WorstDeletion();
     mutations = new FakeAlleleMutation(77);
     listener = new FakeListener();
     codec = new Codec(pool);
@@ -344,6 +463,7 @@ TEST_GROUP(TestDefaultEvolutionAtCapacity)
     delete rules;
     delete crossover;
     delete selection;
+    delete deletion;
     delete mutations;
     delete listener;
     mock().clear();
@@ -365,20 +485,585 @@ TEST(TestDefaultEvolutionAtCapacity, test_evolution)
 			     decision,
 			     *crossover,
 			     *selection,
+			     *deletion,
 			     *mutations,
 			     *listener);
 
   evolution.evolve(*rules);
 
   CHECK_EQUAL(rules->capacity(), rules->size());
+  CHECK_EQUAL(rules->size(), pool.active_rule_count());
 
   mock().checkExpectations();
 }
 
 
 
+TEST_GROUP(TestNicheEvolution)
+{
+  unsigned int		 threshold = 2;
+  MetaRulePool		 pool;
+  Chromosome		 child	  = { 5, 10, 20 };
+  MetaRule		*rule_1, *rule_2, *rule_3;
+  RuleSet		*rules;
+  vector<unsigned int>	 action_set;
+  AlleleMutation	*mutations;
+  Crossover		*crossover;
+  Selection		*selection;
+  Deletion		*deletion;
+  EvolutionListener	*listener;
+  Codec			*codec;
+  Decision		*decision;
+  Evolution		*evolution;
+
+  void setup(void)
+  {
+    rules = new RuleSet(Dimensions(1, 1), 10);
+
+    rule_1 = pool.acquire(Rule({Interval(0, 50)}, { 4 }), Performance(1.0, 2.0, 1.0));
+    rules->add(*rule_1);
+
+    rule_2 = pool.acquire(Rule({Interval(0, 50)}, { 4 }), Performance(1.0, 1.0, 1.0));
+    rules->add(*rule_2);
+
+    rule_3 = pool.acquire(Rule({Interval(50, 100)}, { 6 }), Performance(1.0, 0.5, 1.0));
+    rules->add(*rule_3);
+
+    action_set = { rule_1->slot(), rule_2->slot() };
+
+    crossover = new FakeCrossover(child);
+    selection = new DummySelection();
+    deletion  = new WorstDeletion();
+    mutations = new FakeAlleleMutation(77);
+    listener  = new NoListener();
+    codec     = new Codec(pool);
+    decision  = new FixedDecision(NO_EVOLUTION, NO_MUTATION);
+    evolution = new NicheEvolution(pool,
+				   *codec,
+				   *decision,
+				   *crossover,
+				   *selection,
+				   *deletion,
+				   *mutations,
+				   *listener,
+				   threshold);
+  }
+
+  void teardown(void)
+  {
+    delete evolution;
+    delete decision;
+    delete codec;
+    delete rules;
+    delete crossover;
+    delete selection;
+    delete deletion;
+    delete mutations;
+    delete listener;
+  }
+
+};
+
+
+TEST(TestNicheEvolution, test_no_evolution_of_the_whole_rule_set)
+{
+  RuleSet before_evolution(*rules);
+
+  evolution->evolve(*rules);
+
+  CHECK(*rules == before_evolution);
+}
+
+
+TEST(TestNicheEvolution, test_no_evolution_before_the_threshold)
+{
+  for (unsigned int step=0 ; step<threshold ; ++step) {
+    evolution->evolve_niche(*rules, SlotSpan(action_set));
+  }
+
+  CHECK_EQUAL(3, rules->size());
+  CHECK_EQUAL(0, pool.timestamp(rule_1->slot()));
+}
+
+
+TEST(TestNicheEvolution, test_evolution_once_the_niche_is_due)
+{
+  for (unsigned int step=0 ; step<=threshold ; ++step) {
+    evolution->evolve_niche(*rules, SlotSpan(action_set));
+  }
+
+  CHECK_EQUAL(4, rules->size());
+  vector<unsigned int>	expected_new_rule({ 5, 10, 20 });
+  CHECK(expected_new_rule == (*rules)[3].as_vector());
+  CHECK_EQUAL(pool.now(), pool.timestamp(rule_1->slot()));
+  CHECK_EQUAL(pool.now(), pool.timestamp(rule_2->slot()));
+  CHECK_EQUAL(0, pool.timestamp(rule_3->slot()));
+}
+
+
+TEST(TestNicheEvolution, test_offspring_replace_the_weakest_rule_of_the_niche)
+{
+  RuleSet full(Dimensions(1, 1), 3);
+  full.add(*rule_1).add(*rule_2).add(*rule_3);
+
+  for (unsigned int step=0 ; step<=threshold ; ++step) {
+    evolution->evolve_niche(full, SlotSpan(action_set));
+  }
+
+  CHECK_EQUAL(3, full.size());
+  CHECK(full.remove(*rule_1));
+  CHECK(full.remove(*rule_3));
+  CHECK_EQUAL(3, pool.active_rule_count());
+}
+
+
+TEST(TestNicheEvolution, test_offspring_subsumed_by_an_accurate_rule)
+{
+  MetaRule* subsumer = pool.acquire(Rule({Interval(0, 50)}, { 20 }), Performance(1.0, 1.0, 0.0));
+  for (unsigned int step=0 ; step<=threshold ; ++step) {
+    pool.add_experience(subsumer->slot());
+  }
+  rules->add(*subsumer);
+
+  Subsumption subsumption(1.0, threshold);
+  static_cast<NicheEvolution*>(evolution)->subsume_with(&subsumption);
+
+  for (unsigned int step=0 ; step<=threshold ; ++step) {
+    evolution->evolve_niche(*rules, SlotSpan(action_set));
+  }
+
+  CHECK_EQUAL(4, rules->size());
+  CHECK_EQUAL(2, subsumer->numerosity());
+  CHECK_EQUAL(4, pool.active_rule_count());
+}
+
+
+TEST(TestNicheEvolution, test_no_evolution_of_a_single_rule)
+{
+  action_set = { rule_1->slot() };
+
+  for (unsigned int step=0 ; step<=threshold ; ++step) {
+    evolution->evolve_niche(*rules, SlotSpan(action_set));
+  }
+
+  CHECK_EQUAL(3, rules->size());
+}
+
+
+TEST_GROUP(TestBatchEvolution)
+{
+  unsigned int		 batch_size = 4;
+  MetaRulePool		 pool;
+  Chromosome		 child_1  = { 5, 10, 20 };
+  Chromosome		 child_2  = { 60, 70, 30 };
+  MetaRule		*rule_1, *rule_2;
+  RuleSet		*rules;
+  AlleleMutation	*mutations;
+  Crossover		*crossover_1, *crossover_2;
+  Selection		*selection;
+  Deletion		*deletion;
+  EvolutionListener	*listener;
+  Codec			*codec;
+  Decision		*decision;
+
+  void setup(void)
+  {
+    rules = new RuleSet(Dimensions(1, 1), 10);
+
+    rule_1 = pool.acquire(Rule({Interval(0, 50)}, { 4 }), Performance(1.0, 1.0, 1.0));
+    rules->add(*rule_1);
+
+    rule_2 = pool.acquire(Rule({Interval(50, 100)}, { 2 }), Performance(1.0, 2.0, 1.0));
+    rules->add(*rule_2);
+
+    crossover_1 = new FakeCrossover(child_1);
+    crossover_2 = new FakeCrossover(child_2);
+    selection	= new DummySelection();
+    deletion	= new WorstDeletion();
+    mutations	= new FakeAlleleMutation(77);
+    listener	= new FakeListener();
+    codec	= new Codec(pool);
+    decision	= new FixedDecision(EVOLUTION, NO_MUTATION);
+  }
+
+  void teardown(void)
+  {
+    delete decision;
+    delete codec;
+    delete rules;
+    delete crossover_1;
+    delete crossover_2;
+    delete selection;
+    delete deletion;
+    delete mutations;
+    delete listener;
+    mock().clear();
+  }
+
+};
+
+
+TEST(TestBatchEvolution, test_no_breeder)
+{
+  vector<Breeder> breeders;
+
+  CHECK_THROWS(std::invalid_argument,
+	       BatchEvolution(pool, *codec, *decision, *selection, *deletion, breeders, *listener));
+}
+
+
+TEST(TestBatchEvolution, test_empty_batch)
+{
+  vector<Breeder> breeders = { Breeder(*decision, *crossover_1, *mutations) };
+
+  CHECK_THROWS(std::invalid_argument,
+	       BatchEvolution(pool, *codec, *decision, *selection, *deletion, breeders, *listener, 0));
+}
+
+
+TEST(TestBatchEvolution, test_no_evolution)
+{
+  mock().expectNCalls(0, "on_breeding");
+
+  FixedDecision no_evolution(NO_EVOLUTION, NO_MUTATION);
+  vector<Breeder> breeders = { Breeder(*decision, *crossover_1, *mutations) };
+  BatchEvolution evolution(pool, *codec, no_evolution, *selection, *deletion, breeders, *listener, batch_size);
+
+  evolution.evolve(*rules);
+
+  CHECK_EQUAL(2, rules->size());
+  mock().checkExpectations();
+}
+
+
+TEST(TestBatchEvolution, test_whole_batch_is_merged)
+{
+  mock().expectNCalls(batch_size, "on_breeding");
+  mock().expectNCalls(batch_size, "on_rule_added");
+  mock().expectNCalls(3 * batch_size, "on_mutation");
+
+  FixedDecision mutation(EVOLUTION, MUTATION);
+  vector<Breeder> breeders = { Breeder(mutation, *crossover_1, *mutations) };
+  BatchEvolution evolution(pool, *codec, *decision, *selection, *deletion, breeders, *listener, batch_size);
+
+  evolution.evolve(*rules);
+
+  CHECK_EQUAL(3, rules->size());
+  vector<unsigned int> expected_new_rule({ 77, 77, 77 });
+  CHECK(expected_new_rule == (*rules)[2].as_vector());
+  CHECK_EQUAL(batch_size, (*rules)[2].numerosity());
+  mock().checkExpectations();
+}
+
+
+TEST(TestBatchEvolution, test_breeders_share_the_batch)
+{
+  NoListener quiet;
+  vector<Breeder> breeders = { Breeder(*decision, *crossover_1, *mutations),
+			       Breeder(*decision, *crossover_2, *mutations) };
+  BatchEvolution evolution(pool, *codec, *decision, *selection, *deletion, breeders, quiet, batch_size);
+
+  evolution.evolve(*rules);
+  evolution.evolve(*rules);
+
+  CHECK_EQUAL(4, rules->size());
+  vector<unsigned int> expected_rule_1({ 5, 10, 20 });
+  vector<unsigned int> expected_rule_2({ 60, 70, 30 });
+  CHECK(expected_rule_1 == (*rules)[2].as_vector());
+  CHECK(expected_rule_2 == (*rules)[3].as_vector());
+  CHECK_EQUAL(batch_size, (*rules)[2].numerosity());
+  CHECK_EQUAL(batch_size, (*rules)[3].numerosity());
+}
+
+
+TEST(TestBatchEvolution, test_deletion_makes_room_for_the_batch)
+{
+  MetaRule* weakest = pool.acquire(Rule({Interval(20, 30)}, { 8 }), Performance(1.0, 0.5, 1.0));
+  RuleSet full(Dimensions(1, 1), 3);
+  full.add(*rule_1).add(*rule_2).add(*weakest);
+
+  NoListener quiet;
+  vector<Breeder> breeders = { Breeder(*decision, *crossover_1, *mutations) };
+  BatchEvolution evolution(pool, *codec, *decision, *selection, *deletion, breeders, quiet, 1);
+
+  evolution.evolve(full);
+
+  CHECK_EQUAL(3, full.size());
+  CHECK(full.contains(*rule_1));
+  CHECK(full.contains(*rule_2));
+  CHECK_EQUAL(3, pool.active_rule_count());
+}
+
+
+TEST_GROUP(TestBackgroundEvolution)
+{
+  unsigned int		 capacity = 10;
+  MetaRulePool		 pool;
+  MetaRulePool		 worker_pool;
+  Chromosome		 child	  = { 5, 10, 20 };
+  MetaRule		*rule_1, *rule_2;
+  RuleSet		*rules;
+  AlleleMutation	*mutations;
+  Crossover		*crossover;
+  Selection		*selection;
+  Deletion		*deletion;
+  EvolutionListener	*listener;
+  Codec			*codec;
+  Decision		*decision;
+  Evolution		*worker_evolution;
+
+  void setup(void)
+  {
+    rules = new RuleSet(Dimensions(1, 1), capacity);
+
+    rule_1 = pool.acquire(Rule({Interval(0, 50)}, { 4 }), Performance(1.0, 1.0, 1.0));
+    rules->add(*rule_1);
+
+    rule_2 = pool.acquire(Rule({Interval(50, 100)}, { 2 }), Performance(1.0, 2.0, 1.0));
+    rules->add(*rule_2);
+
+    crossover = new FakeCrossover(child);
+    selection = new DummySelection();
+    deletion  = new WorstDeletion();
+    mutations = new FakeAlleleMutation(77);
+    listener  = new NoListener();
+    codec     = new Codec(worker_pool);
+    decision  = new FixedDecision(EVOLUTION, NO_MUTATION);
+    worker_evolution = new DefaultEvolution(worker_pool,
+					    *codec,
+					    *decision,
+					    *crossover,
+					    *selection,
+					    *deletion,
+					    *mutations,
+					    *listener);
+  }
+
+  void teardown(void)
+  {
+    delete worker_evolution;
+    delete decision;
+    delete codec;
+    delete rules;
+    delete crossover;
+    delete selection;
+    delete deletion;
+    delete mutations;
+    delete listener;
+  }
+
+};
+
+
+TEST(TestBackgroundEvolution, test_no_evolution)
+{
+  RuleSet before_evolution(*rules);
+  FixedDecision no_evolution(NO_EVOLUTION, NO_MUTATION);
+  BackgroundEvolution evolution(pool, no_evolution, *deletion, *worker_evolution, worker_pool);
+
+  evolution.evolve(*rules);
+  evolution.synchronise();
+  evolution.evolve(*rules);
+
+  CHECK(*rules == before_evolution);
+}
+
+
+TEST(TestBackgroundEvolution, test_children_are_added_by_the_next_request)
+{
+  RuleSet before_evolution(*rules);
+  BackgroundEvolution evolution(pool, *decision, *deletion, *worker_evolution, worker_pool);
+
+  evolution.evolve(*rules);
+  CHECK(*rules == before_evolution);
+
+  evolution.synchronise();
+  evolution.evolve(*rules);
+  evolution.synchronise();
+
+  CHECK_EQUAL(before_evolution.size() + 1, rules->size());
+  vector<unsigned int>	expected_new_rule({ 5, 10, 20 });
+  CHECK(expected_new_rule == (*rules)[2].as_vector());
+  CHECK_EQUAL(rules->size(), pool.active_rule_count());
+  CHECK_EQUAL(0, worker_pool.active_rule_count());
+}
+
+
+TEST(TestBackgroundEvolution, test_twin_children_raise_the_original_numerosity)
+{
+  pool.set_numerosity(rule_1->slot(), 3);
+  Chromosome twin_of_rule_1 = { 0, 50, 4 };
+  FakeCrossover twin_crossover(twin_of_rule_1);
+  DefaultEvolution twin_evolution(worker_pool,
+				  *codec,
+				  *decision,
+				  twin_crossover,
+				  *selection,
+				  *deletion,
+				  *mutations,
+				  *listener);
+  BackgroundEvolution evolution(pool, *decision, *deletion, twin_evolution, worker_pool);
+
+  evolution.evolve(*rules);
+  evolution.synchronise();
+  evolution.evolve(*rules);
+  evolution.synchronise();
+
+  CHECK_EQUAL(2, rules->size());
+  CHECK_EQUAL(4, rule_1->numerosity());
+  CHECK_EQUAL(1, rule_2->numerosity());
+  CHECK_EQUAL(0, worker_pool.active_rule_count());
+}
+
+
+TEST(TestBackgroundEvolution, test_full_rule_set_is_left_alone)
+{
+  MetaRule* rule_3 = pool.acquire(Rule({Interval(0, 50)}, { 6 }), Performance(1.0, 3.0, 1.0));
+  RuleSet full(Dimensions(1, 1), 3);
+  full.add(*rule_1).add(*rule_2).add(*rule_3);
+  FixedDecision no_evolution(NO_EVOLUTION, NO_MUTATION);
+  BackgroundEvolution evolution(pool, no_evolution, *deletion, *worker_evolution, worker_pool);
+
+  evolution.evolve(full);
+  evolution.synchronise();
+  evolution.evolve(full);
+
+  CHECK_EQUAL(3, full.size());
+  CHECK_EQUAL(3, pool.active_rule_count());
+}
+
+
+TEST(TestBackgroundEvolution, test_make_room_through_the_deletion)
+{
+  MetaRule* rule_3 = pool.acquire(Rule({Interval(0, 50)}, { 6 }), Performance(1.0, 3.0, 1.0));
+  RuleSet full(Dimensions(1, 1), 3);
+  full.add(*rule_1).add(*rule_2).add(*rule_3);
+  RuleHandle weakest = pool.handle(rule_1->slot());
+  BackgroundEvolution evolution(pool, *decision, *deletion, *worker_evolution, worker_pool);
+
+  evolution.make_room(full, 1);
+
+  CHECK_EQUAL(2, full.size());
+  CHECK(not pool.is_current(weakest));
+
+  evolution.make_room(full, 1);
+
+  CHECK_EQUAL(2, full.size());
+}
+
+
+TEST(TestBackgroundEvolution, test_children_make_room_in_a_full_rule_set)
+{
+  MetaRule* rule_3 = pool.acquire(Rule({Interval(0, 50)}, { 6 }), Performance(1.0, 3.0, 1.0));
+  RuleSet full(Dimensions(1, 1), 3);
+  full.add(*rule_1).add(*rule_2).add(*rule_3);
+  BackgroundEvolution evolution(pool, *decision, *deletion, *worker_evolution, worker_pool);
+
+  evolution.evolve(full);
+  CHECK_EQUAL(3, full.size());
+
+  evolution.synchronise();
+  evolution.evolve(full);
+  evolution.synchronise();
+
+  CHECK_EQUAL(3, full.size());
+  vector<unsigned int> expected_new_rule({ 5, 10, 20 });
+  CHECK(expected_new_rule == full[2].as_vector());
+  CHECK_EQUAL(full.size(), pool.active_rule_count());
+  CHECK_EQUAL(0, worker_pool.active_rule_count());
+}
+
+
+TEST(TestBackgroundEvolution, test_stale_deletions_are_ignored)
+{
+  MetaRule* rule_3 = pool.acquire(Rule({Interval(0, 50)}, { 6 }), Performance(1.0, 3.0, 1.0));
+  RuleSet full(Dimensions(1, 1), 3);
+  full.add(*rule_1).add(*rule_2).add(*rule_3);
+  BackgroundEvolution evolution(pool, *decision, *deletion, *worker_evolution, worker_pool);
+
+  evolution.evolve(full);
+  evolution.synchronise();
+  evolution.make_room(full, 1);
+
+  MetaRule* newcomer = pool.acquire(Rule({Interval(0, 50)}, { 8 }), Performance(1.0, 5.0, 1.0));
+  CHECK_EQUAL(rule_1->slot(), newcomer->slot());
+  full.add(*newcomer);
+
+  evolution.evolve(full);
+
+  CHECK(pool.is_active(newcomer));
+  CHECK(full.remove(*newcomer));
+}
+
+
+/**
+ * Worker evolution which evolves the first snapshot only
+ */
+class OnceEvolution
+  : public Evolution
+{
+public:
+  OnceEvolution(const Evolution& delegate)
+    : _delegate(delegate)
+    , _done(false)
+  {}
+
+  virtual void initialise(RuleSet& rules) const
+  {
+    _delegate.initialise(rules);
+  }
+
+  virtual void evolve(RuleSet& rules) const
+  {
+    if (_done) return;
+    _delegate.evolve(rules);
+    _done = true;
+  }
+
+private:
+  const Evolution&	_delegate;
+  mutable bool		_done;
+};
+
+
+TEST(TestBackgroundEvolution, test_rounds_without_children_add_nothing)
+{
+  OnceEvolution once(*worker_evolution);
+  BackgroundEvolution evolution(pool, *decision, *deletion, once, worker_pool);
+
+  evolution.evolve(*rules);
+  evolution.synchronise();
+  evolution.evolve(*rules);
+  evolution.synchronise();
+  CHECK_EQUAL(3, rules->size());
+
+  for (unsigned int round=0 ; round<3 ; ++round) {
+    evolution.evolve(*rules);
+    evolution.synchronise();
+  }
+
+  CHECK_EQUAL(3, rules->size());
+  CHECK_EQUAL(1, (*rules)[2].numerosity());
+  CHECK_EQUAL(rules->size(), pool.active_rule_count());
+}
+
+
+TEST(TestBackgroundEvolution, test_initialise)
+{
+  RuleSet seeded(Dimensions(1, 1), 10);
+  BackgroundEvolution evolution(pool, *decision, *deletion, *worker_evolution, worker_pool);
+
+  evolution.initialise(seeded);
+
+  CHECK_EQUAL(2, seeded.size());
+  CHECK(&seeded.pool() == &pool);
+  CHECK_EQUAL(0, worker_pool.active_rule_count());
+}
+
+
 TEST_GROUP(TestLogListener)
 {
+  MetaRulePool pool;
   stringstream out;
   EvolutionListener *listener;
 
@@ -397,7 +1082,7 @@ TEST_GROUP(TestLogListener)
 
 TEST(TestLogListener, test_on_rule_added)
 {
-  MetaRule rule(Rule({Interval(0, 100)}, { 50 }), Performance(1., 1., 1.));
+  MetaRule& rule = *pool.acquire(Rule({Interval(0, 100)}, { 50 }), Performance(1., 1., 1.));
 
   listener->on_rule_added(rule);
 
@@ -409,7 +1094,7 @@ TEST(TestLogListener, test_on_rule_added)
 
 TEST(TestLogListener, test_on_rule_deleted)
 {
-  MetaRule rule(Rule({Interval(0, 100)}, { 50 }), Performance(1., 1., 1.));
+  MetaRule& rule = *pool.acquire(Rule({Interval(0, 100)}, { 50 }), Performance(1., 1., 1.));
 
   listener->on_rule_deleted(rule);
 
@@ -421,8 +1106,8 @@ TEST(TestLogListener, test_on_rule_deleted)
 
 TEST(TestLogListener, test_on_breeding)
 {
-  MetaRule father(Rule({Interval(0, 50)}, { 50 }), Performance(1., 1., 1.));
-  MetaRule mother(Rule({Interval(50, 75)}, { 67 }), Performance(1., 1., 1.));
+  MetaRule& father = *pool.acquire(Rule({Interval(0, 50)}, { 50 }), Performance(1., 1., 1.));
+  MetaRule& mother = *pool.acquire(Rule({Interval(50, 75)}, { 67 }), Performance(1., 1., 1.));
 
   listener->on_breeding(father, mother);
 
@@ -438,7 +1123,7 @@ TEST(TestLogListener, test_on_breeding)
 TEST(TestLogListener, test_on_mutation)
 {
   Chromosome individual({ 10, 20, 30, 40 });
-  Allele locus(2);
+  Locus locus(2);
 
   listener->on_mutation(individual, locus);
 
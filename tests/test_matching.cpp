@@ -0,0 +1,269 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdexcept>
+
+#include "CppUTest/TestHarness.h"
+
+#include "matching.h"
+
+
+using namespace xcsf;
+
+
+TEST_GROUP(TestMatchKernels)
+{
+  const unsigned int slot_count = 150;
+  Columns lower_bounds;
+  Columns upper_bounds;
+
+  void setup(void)
+  {
+    lower_bounds.assign(3, std::vector<Level>(slot_count));
+    upper_bounds.assign(3, std::vector<Level>(slot_count));
+    for (unsigned int slot=0 ; slot<slot_count ; ++slot) {
+      for (unsigned int index=0 ; index<3 ; ++index) {
+	const unsigned int centre = (slot * 37 + index * 11) % (Value::MAXIMUM + 1);
+	const unsigned int spread = (slot + index) % 30;
+	lower_bounds[index][slot] = centre > spread ? centre - spread : 0;
+	upper_bounds[index][slot] = std::min(centre + spread, Value::MAXIMUM);
+      }
+    }
+  }
+
+  void verify(MatchKernel kernel)
+  {
+    const int maximum = Value::MAXIMUM;
+    for (int value=0 ; value<=maximum ; value += maximum / 14 + 1) {
+      const Vector input({ value, (value * 3) % (maximum + 1), maximum - value });
+      Bitmask expected(slot_count);
+      Bitmask actual(slot_count);
+
+      MatchKernels::scalar(lower_bounds, upper_bounds, input, expected);
+      kernel(lower_bounds, upper_bounds, input, actual);
+
+      for (unsigned int slot=0 ; slot<slot_count ; ++slot) {
+	CHECK_EQUAL(expected[slot], actual[slot]);
+      }
+    }
+  }
+
+};
+
+
+TEST(TestMatchKernels, test_scalar)
+{
+  Bitmask matches(slot_count);
+  MatchKernels::scalar(lower_bounds, upper_bounds, Vector({ 0, 0, 0 }), matches);
+
+  for (unsigned int slot=0 ; slot<slot_count ; ++slot) {
+    bool expected = lower_bounds[0][slot] == 0
+      and lower_bounds[1][slot] == 0
+      and lower_bounds[2][slot] == 0;
+    CHECK_EQUAL(expected, matches[slot]);
+  }
+}
+
+
+TEST(TestMatchKernels, test_sse4_agrees_with_scalar)
+{
+  if (not MatchKernels::supports_sse4()) return;
+  verify(&MatchKernels::sse4);
+}
+
+
+TEST(TestMatchKernels, test_avx2_agrees_with_scalar)
+{
+  if (not MatchKernels::supports_avx2()) return;
+  verify(&MatchKernels::avx2);
+}
+
+
+TEST(TestMatchKernels, test_fastest_agrees_with_scalar)
+{
+  verify(MatchKernels::fastest());
+}
+
+
+TEST(TestMatchKernels, test_specialised_scalar_agrees_with_scalar)
+{
+  verify(MatchKernels::scalar_for(3));
+}
+
+
+TEST(TestMatchKernels, test_specialised_sse4_agrees_with_scalar)
+{
+  if (not MatchKernels::supports_sse4()) return;
+  verify(MatchKernels::sse4_for(3));
+}
+
+
+TEST(TestMatchKernels, test_specialised_avx2_agrees_with_scalar)
+{
+  if (not MatchKernels::supports_avx2()) return;
+  verify(MatchKernels::avx2_for(3));
+}
+
+
+TEST(TestMatchKernels, test_specialisation_picks_the_input_count)
+{
+  CHECK(MatchKernels::scalar_for(3) != MatchKernels::scalar_for(4));
+  CHECK(MatchKernels::scalar_for(3) != &MatchKernels::scalar);
+}
+
+
+TEST(TestMatchKernels, test_generic_kernel_beyond_the_specialisations)
+{
+  const unsigned int input_count = MatchKernels::MAX_SPECIALISED_INPUTS + 1;
+
+  CHECK(&MatchKernels::scalar == MatchKernels::scalar_for(input_count));
+  CHECK(&MatchKernels::sse4 == MatchKernels::sse4_for(input_count));
+  CHECK(&MatchKernels::avx2 == MatchKernels::avx2_for(input_count));
+}
+
+
+
+TEST_GROUP(TestValueIndex)
+{
+  Columns lower_bounds = { { 10, 30, 0 }, { 0, 50, 20 } };
+  Columns upper_bounds = { { 20, 40, 100 }, { 100, 60, 25 } };
+  ValueIndex *index;
+
+  void setup(void)
+  {
+    index = new ValueIndex(2);
+    for (unsigned int slot=0 ; slot<3 ; ++slot) {
+      index->insert(lower_bounds, upper_bounds, slot);
+    }
+  }
+
+  void teardown(void)
+  {
+    delete index;
+  }
+
+};
+
+
+TEST(TestValueIndex, test_match)
+{
+  Bitmask matches(3);
+  index->match(Vector({ 15, 22 }), matches);
+
+  CHECK(matches[0]);
+  CHECK_FALSE(matches[1]);
+  CHECK(matches[2]);
+}
+
+
+TEST(TestValueIndex, test_erase)
+{
+  index->erase(lower_bounds, upper_bounds, 0);
+
+  Bitmask matches(3);
+  index->match(Vector({ 15, 22 }), matches);
+
+  CHECK_FALSE(matches[0]);
+  CHECK(matches[2]);
+}
+
+
+TEST(TestValueIndex, test_agrees_with_scalar_kernel)
+{
+  for (int value=0 ; value<=100 ; value += 5) {
+    const Vector input({ value, 100 - value });
+    Bitmask expected(3);
+    Bitmask actual(3);
+
+    MatchKernels::scalar(lower_bounds, upper_bounds, input, expected);
+    index->match(input, actual);
+
+    for (unsigned int slot=0 ; slot<3 ; ++slot) {
+      CHECK_EQUAL(expected[slot], actual[slot]);
+    }
+  }
+}
+
+
+
+TEST_GROUP(TestGridIndex)
+{
+  Columns lower_bounds = { { 10, 30, 0 }, { 0, 50, 20 } };
+  Columns upper_bounds = { { 20, 40, 100 }, { 100, 60, 25 } };
+  GridIndex *index;
+
+  void setup(void)
+  {
+    index = new GridIndex(2, 7);
+    for (unsigned int slot=0 ; slot<3 ; ++slot) {
+      index->insert(lower_bounds, upper_bounds, slot);
+    }
+  }
+
+  void teardown(void)
+  {
+    delete index;
+  }
+
+};
+
+
+TEST(TestGridIndex, test_invalid_cell_width)
+{
+  CHECK_THROWS(std::invalid_argument, {GridIndex index(2, 0);});
+}
+
+
+TEST(TestGridIndex, test_match)
+{
+  Bitmask matches(3);
+  index->match(Vector({ 15, 22 }), matches);
+
+  CHECK(matches[0]);
+  CHECK_FALSE(matches[1]);
+  CHECK(matches[2]);
+}
+
+
+TEST(TestGridIndex, test_erase)
+{
+  index->erase(lower_bounds, upper_bounds, 0);
+
+  Bitmask matches(3);
+  index->match(Vector({ 15, 22 }), matches);
+
+  CHECK_FALSE(matches[0]);
+  CHECK(matches[2]);
+}
+
+
+TEST(TestGridIndex, test_agrees_with_scalar_kernel)
+{
+  for (int value=0 ; value<=100 ; ++value) {
+    const Vector input({ value, 100 - value });
+    Bitmask expected(3);
+    Bitmask actual(3);
+
+    MatchKernels::scalar(lower_bounds, upper_bounds, input, expected);
+    index->match(input, actual);
+
+    for (unsigned int slot=0 ; slot<3 ; ++slot) {
+      CHECK_EQUAL(expected[slot], actual[slot]);
+    }
+  }
+}
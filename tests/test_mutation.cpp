@@ -43,7 +43,7 @@ TEST_GROUP(TestAlleleMutation)
   {
     initial = 50;
     maximum = 30;
-    randomizer = new TestableRandomizer({ 0, 0.51, 1.0 });
+    randomizer = new TestableRandomizer({ 0, 0.5, 1.0 });
     mutation = new RandomAlleleMutation(*randomizer, maximum);
    
   }
@@ -69,7 +69,7 @@ TEST(TestAlleleMutation, test_simple_mutation)
   CHECK_EQUAL(initial, chromosome[1]);
   
   (*mutation)(chromosome, 2);
-  CHECK_EQUAL(initial + maximum -1, chromosome[2]);
+  CHECK_EQUAL(initial + maximum, chromosome[2]);
 }
 
 TEST(TestAlleleMutation, test_underflow)
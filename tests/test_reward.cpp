@@ -18,6 +18,7 @@
 
 #include "CppUTest/TestHarness.h"
 
+#include <cmath>
 #include <sstream>
 
 #include "reward.h"
@@ -34,19 +35,19 @@ TEST_GROUP(TestNaiveReward)
   const double fitness = 0.0;
   const double payoff = 0.0;
 
+  MetaRulePool pool;
   MetaRule *rule;
   RuleSet rules;
   RewardFunction* reward;
   
   void setup(void) {
-    rule = new MetaRule(Rule({ Interval(0, 100) }, { 50 }),
+    rule = pool.acquire(Rule({ Interval(0, 100) }, { 50 }),
 			Performance(fitness, payoff, 0));
     rules.add(*rule);
     reward = new NaiveReward(learning_rate);
   }
 
   void teardown(void) {
-    delete rule;
     delete reward;
   }
   
@@ -85,23 +86,22 @@ TEST_GROUP(TestNaiveRewardWithTwoRules)
   const double fitness = 0.0;
   const double payoff = 0.0;
 
+  MetaRulePool pool;
   MetaRule *rule_1, *rule_2;
   RuleSet rules;
   RewardFunction* reward;
   
   void setup(void) {
-    rule_1 = new MetaRule(Rule({ Interval(0, 100) }, { 50 }),
+    rule_1 = pool.acquire(Rule({ Interval(0, 100) }, { 50 }),
 			  Performance(fitness, payoff, 0));
     rules.add(*rule_1);
-    rule_2 = new MetaRule(Rule({ Interval(0, 100) }, { 50 }),
+    rule_2 = pool.acquire(Rule({ Interval(0, 100) }, { 50 }),
 			  Performance(fitness, payoff, 0));
     rules.add(*rule_2);
     reward = new NaiveReward(learning_rate);
   }
 
   void teardown(void) {
-    delete rule_1;
-    delete rule_2;
     delete reward;
   }
   
@@ -138,3 +138,76 @@ TEST(TestNaiveRewardWithTwoRules, 2x100_reward)
   DOUBLES_EQUAL(0.5, rule_2->fitness(), TOLERANCE);
   DOUBLES_EQUAL(100, rule_2->payoff(), TOLERANCE);
 }
+
+
+TEST(TestNaiveRewardWithTwoRules, numerosity_weighs_the_relative_accuracy)
+{
+  pool.set_numerosity(rule_2->slot(), 3);
+
+  (*reward)(100, rules);
+  (*reward)(100, rules);
+
+  DOUBLES_EQUAL(0.25, rule_1->fitness(), TOLERANCE);
+  DOUBLES_EQUAL(0.75, rule_2->fitness(), TOLERANCE);
+}
+
+
+TEST_GROUP(TestWilsonReward)
+{
+  const double learning_rate = 0.5;
+  const double error_threshold = 10;
+
+  MetaRulePool pool;
+  MetaRule *accurate, *inaccurate;
+  RuleSet rules;
+
+  void setup(void) {
+    accurate = pool.acquire(Rule({ Interval(0, 100) }, { 50 }), Performance(0, 100, 0));
+    inaccurate = pool.acquire(Rule({ Interval(0, 100) }, { 60 }), Performance(0, 0, 20));
+    rules.add(*accurate).add(*inaccurate);
+  }
+
+  void check_update(double v)
+  {
+    WilsonReward reward(learning_rate, error_threshold, v);
+
+    reward(100, rules);
+
+    const double error = 20 + learning_rate * 50;
+    const double accuracy = 0.1 * std::pow(error / error_threshold, -v);
+    DOUBLES_EQUAL(100, accurate->payoff(), TOLERANCE);
+    DOUBLES_EQUAL(0, accurate->error(), TOLERANCE);
+    DOUBLES_EQUAL(50, inaccurate->payoff(), TOLERANCE);
+    DOUBLES_EQUAL(error, inaccurate->error(), TOLERANCE);
+    DOUBLES_EQUAL(learning_rate / (1 + accuracy), accurate->fitness(), TOLERANCE);
+    DOUBLES_EQUAL(learning_rate * accuracy / (1 + accuracy), inaccurate->fitness(), TOLERANCE);
+  }
+
+};
+
+
+TEST(TestWilsonReward, test_integer_exponent)
+{
+  check_update(2);
+}
+
+
+TEST(TestWilsonReward, test_real_exponent)
+{
+  check_update(2.5);
+}
+
+
+TEST(TestWilsonReward, test_large_action_set)
+{
+  RuleSet large(Dimensions(1, 1), 500000);
+  for (unsigned int index=0 ; index<large.capacity() ; ++index) {
+    large.add(*pool.acquire(Rule({ Interval(0, 100) }, { static_cast<int>(index % 100) }), Performance(0, 0, 0)));
+  }
+  WilsonReward reward(1, error_threshold, 5);
+
+  reward(1, large);
+
+  DOUBLES_EQUAL(2e-6, large[0].fitness(), 1e-12);
+  DOUBLES_EQUAL(1, large[large.size() - 1].payoff(), TOLERANCE);
+}
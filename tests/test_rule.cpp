@@ -18,6 +18,7 @@
 
 #include "CppUTest/TestHarness.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "rule.h"
@@ -276,16 +277,13 @@ TEST_GROUP(TestSimpleRule)
   const double fitness = 0.75;
   const double payoff = 0.75;
   const double error = 1.0;
+  MetaRulePool pool;
   MetaRule* rule;
 
   void setup() {
-    rule = new MetaRule(Rule({ Interval(0, 50) }, { 50 }),
+    rule = pool.acquire(Rule({ Interval(0, 50) }, { 50 }),
 			Performance(fitness, payoff, error));
   }
-  
-  void teardown() {
-    delete rule;
-  }
 
 };
 
@@ -331,13 +329,10 @@ TEST_GROUP(Test3DRule)
   const double fitness = 0.75;
   const double payoff = 0.75;
   const double error = 0.1;
-  const MetaRule& rule = *new MetaRule(Rule({Interval(20, 30), Interval(10, 15), Interval(80, 99)},
+  MetaRulePool pool = { Dimensions(3, 1) };
+  const MetaRule& rule = *pool.acquire(Rule({Interval(20, 30), Interval(10, 15), Interval(80, 99)},
 					    { 1 }),
 				       Performance(fitness, payoff, error));
-  
-  void teardown() {
-    delete &rule;
-  }
 
 };
 
@@ -379,19 +374,17 @@ TEST_GROUP(TestRuleSet)
   void setup(void) {
     rules = new RuleSet(Dimensions(1, 1), capacity);
     
-    rule_1 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_1 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(r1_fitness, r1_payoff, r1_error));
     rules->add(*rule_1);
 
-    rule_2 = new MetaRule(Rule({ Interval(25, 50) }, { 37 }),
+    rule_2 = pool.acquire(Rule({ Interval(25, 50) }, { 37 }),
 			  Performance(r2_fitness, r2_payoff, r2_error));
     rules->add(*rule_2);
   }
 
 
   void teardown(void) {
-    delete rule_1;
-    delete rule_2;
     delete rules;
   }
 };
@@ -403,6 +396,75 @@ TEST(TestRuleSet, test_remove_the_worst_rule)
   CHECK((*rules)[0] == *rule_2);
 }
 
+TEST(TestRuleSet, test_remove_a_given_rule)
+{
+  MetaRule *rule_3 = pool.acquire(Rule({ Interval(40, 50) }, { 43 }));
+  rules->add(*rule_3);
+
+  CHECK(rules->remove(*rule_1));
+  CHECK_FALSE(rules->remove(*rule_1));
+
+  CHECK_EQUAL(2, rules->size());
+  CHECK(rules->remove(*rule_2));
+  CHECK(rules->remove(*rule_3));
+  CHECK(rules->is_empty());
+}
+
+TEST(TestRuleSet, test_clear)
+{
+  rules->clear();
+
+  CHECK(rules->is_empty());
+  CHECK_FALSE(rules->remove(*rule_1));
+  rules->add(*rule_1);
+  CHECK(rules->remove(*rule_1));
+}
+
+TEST(TestRuleSet, test_merge_an_identical_rule)
+{
+  MetaRule *clone = pool.acquire(Rule({ Interval(0, 25) }, { 12 }));
+
+  MetaRule& merged = rules->merge(*clone);
+
+  CHECK(&merged == rule_1);
+  CHECK_EQUAL(2, rules->size());
+  CHECK_EQUAL(2, rule_1->numerosity());
+  CHECK(pool.is_free(clone));
+}
+
+TEST(TestRuleSet, test_capacity_counts_distinct_rules)
+{
+  RuleSet small(Dimensions(1, 1), 2);
+  small.add(*rule_1);
+  MetaRule *clone = pool.acquire(Rule({ Interval(0, 25) }, { 12 }));
+
+  small.merge(*clone);
+
+  CHECK_EQUAL(2, rule_1->numerosity());
+  CHECK_EQUAL(1, small.remaining_capacity());
+}
+
+TEST(TestRuleSet, test_merge_a_new_rule)
+{
+  MetaRule *rule_3 = pool.acquire(Rule({ Interval(0, 25) }, { 13 }));
+
+  MetaRule& merged = rules->merge(*rule_3);
+
+  CHECK(&merged == rule_3);
+  CHECK_EQUAL(3, rules->size());
+  CHECK_EQUAL(1, rule_3->numerosity());
+}
+
+TEST(TestRuleSet, test_twin_belongs_to_the_set)
+{
+  MetaRule *outsider = pool.acquire(Rule({ Interval(40, 50) }, { 43 }));
+  MetaRule *clone = pool.acquire(Rule({ Interval(40, 50) }, { 43 }));
+
+  CHECK(rules->twin(*clone) == nullptr);
+  CHECK(rules->twin(*rule_1) == nullptr);
+  CHECK_FALSE(rules->contains(*outsider));
+}
+
 TEST(TestRuleSet, test_total_fitness)
 {
   double total_fitness = rules->total_fitness();
@@ -497,14 +559,13 @@ TEST(TestMetaRulePool, test_reusing_rules)
 
 TEST(TestMetaRulePool, test_releasing_a_foreign_rule)
 {
-  MetaRule *foreign_rule = new MetaRule(Rule({Interval(10, 20)}, { 35 }), Performance(0, 0, 0));
+  MetaRulePool other_pool;
+  MetaRule *foreign_rule = other_pool.acquire(Rule({Interval(10, 20)}, { 35 }), Performance(0, 0, 0));
 
   CHECK_THROWS(std::invalid_argument,
 	       {
 		 pool.release(foreign_rule);
 	       });
-
-  delete foreign_rule;
 }
 
 TEST(TestMetaRulePool, test_releasing_twice_the_same_rule)
@@ -518,3 +579,319 @@ TEST(TestMetaRulePool, test_releasing_twice_the_same_rule)
 }
 
 
+
+TEST(TestMetaRulePool, test_columns)
+{
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }), Performance(1, 2, 3));
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(30, 40)}, { 45 }), Performance(4, 5, 6));
+
+  CHECK_EQUAL(2, pool.slot_count());
+  CHECK_EQUAL(10, pool.lower_bounds(0)[rule_1->slot()]);
+  CHECK_EQUAL(40, pool.upper_bounds(0)[rule_2->slot()]);
+  CHECK_EQUAL(45, pool.conclusions(0)[rule_2->slot()]);
+  DOUBLES_EQUAL(5, pool.payoff(rule_2->slot()), 1e-6);
+}
+
+
+TEST(TestMetaRulePool, test_acquire_with_invalid_dimensions)
+{
+  CHECK_THROWS(std::invalid_argument,
+	       {
+		 pool.acquire(Rule({Interval(10, 20), Interval(10, 20)}, { 35 }));
+	       });
+}
+
+
+TEST(TestMetaRulePool, test_acquire_swaps_reversed_bounds)
+{
+  MetaRule *rule = pool.acquire(vector<Level>({ 20, 10, 35 }), Performance(0, 0, 0));
+
+  CHECK(Rule({Interval(10, 20)}, { 35 }) == rule->rule());
+}
+
+
+TEST(TestMetaRulePool, test_match)
+{
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(15, 40)}, { 45 }));
+  MetaRule *rule_3 = pool.acquire(Rule({Interval(30, 40)}, { 45 }));
+
+  Bitmask matches;
+  pool.match(Vector({ 17 }), matches);
+
+  CHECK(matches[rule_1->slot()]);
+  CHECK(matches[rule_2->slot()]);
+  CHECK_FALSE(matches[rule_3->slot()]);
+}
+
+
+TEST(TestRuleSet, test_add_rule_from_another_pool)
+{
+  MetaRulePool other_pool;
+  MetaRule *foreign_rule = other_pool.acquire(Rule({ Interval(40, 50) }, { 43 }));
+
+  CHECK_THROWS(std::invalid_argument,
+	       {
+		 rules->add(*foreign_rule);
+	       });
+}
+
+
+TEST(TestRuleSet, test_activation_group)
+{
+  ActivationGroup active_rules(*rules, Vector({ 10 }));
+
+  CHECK_EQUAL(1, active_rules.size());
+  CHECK(&active_rules[0] == rule_1);
+}
+
+
+TEST(TestMetaRulePool, test_index_follows_acquire_and_release)
+{
+  ValueIndex index(1);
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  pool.index_with(&index);
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(15, 40)}, { 45 }));
+  pool.release(rule_1);
+
+  Bitmask matches;
+  pool.match(Vector({ 17 }), matches);
+
+  CHECK_FALSE(matches[rule_1->slot()]);
+  CHECK(matches[rule_2->slot()]);
+}
+
+
+TEST(TestMetaRulePool, test_grid_index_follows_acquire_and_release)
+{
+  GridIndex index(1);
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  pool.index_with(&index);
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(15, 40)}, { 45 }));
+  MetaRule *rule_3 = pool.acquire(Rule({Interval(60, 80)}, { 45 }));
+  pool.release(rule_1);
+
+  Bitmask matches;
+  pool.match(Vector({ 17 }), matches);
+
+  CHECK_FALSE(matches[rule_1->slot()]);
+  CHECK(matches[rule_2->slot()]);
+  CHECK_FALSE(matches[rule_3->slot()]);
+}
+
+
+TEST(TestMetaRulePool, test_conclusion_hash)
+{
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(50, 60)}, { 35 }));
+  MetaRule *rule_3 = pool.acquire(Rule({Interval(10, 20)}, { 36 }));
+
+  CHECK_EQUAL(pool.conclusion_hash(rule_1->slot()), pool.conclusion_hash(rule_2->slot()));
+  CHECK(pool.same_conclusions(rule_1->slot(), rule_2->slot()));
+  CHECK_FALSE(pool.same_conclusions(rule_1->slot(), rule_3->slot()));
+}
+
+
+
+TEST_GROUP(TestPredictionArray)
+{
+  MetaRulePool pool;
+  PredictionArray predictions;
+  vector<unsigned int> match_set;
+
+  void define(const Rule& rule, const Performance& performance)
+  {
+    match_set.push_back(pool.acquire(rule, performance)->slot());
+  }
+
+};
+
+
+TEST(TestPredictionArray, test_select_the_most_rewarding_prediction)
+{
+  define(Rule({Interval(0, 100)}, { 4 }), Performance(1.0, 1.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 3 }), Performance(0.5, 2.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 4 }), Performance(0.8, 0.8, 1.0));
+
+  predictions.select(pool, match_set);
+
+  CHECK(Vector({ 3 }) == predictions.prediction());
+  CHECK_EQUAL(1, predictions.action_set().size());
+  CHECK_EQUAL(match_set[1], predictions.action_set()[0]);
+}
+
+
+TEST(TestPredictionArray, test_action_set_gathers_the_same_prediction)
+{
+  define(Rule({Interval(0, 100)}, { 4 }), Performance(1.0, 1.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 3 }), Performance(0.5, 0.5, 1.0));
+  define(Rule({Interval(0, 100)}, { 4 }), Performance(0.8, 0.8, 1.0));
+
+  predictions.select(pool, match_set);
+
+  CHECK(Vector({ 4 }) == predictions.prediction());
+  CHECK_EQUAL(2, predictions.action_set().size());
+  CHECK_EQUAL(match_set[0], predictions.action_set()[0]);
+  CHECK_EQUAL(match_set[2], predictions.action_set()[1]);
+}
+
+
+TEST(TestPredictionArray, test_ties_go_to_the_lowest_prediction)
+{
+  define(Rule({Interval(0, 100)}, { 7 }), Performance(1.0, 1.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 2 }), Performance(1.0, 1.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 5 }), Performance(1.0, 1.0, 1.0));
+
+  predictions.select(pool, match_set);
+
+  CHECK(Vector({ 2 }) == predictions.prediction());
+}
+
+
+TEST(TestPredictionArray, test_ties_without_fitness_go_to_the_lowest_prediction)
+{
+  define(Rule({Interval(0, 100)}, { 30 }), Performance(0.0, 1.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 0 }), Performance(0.0, 1.0, 1.0));
+
+  predictions.select(pool, match_set);
+  CHECK(Vector({ 0 }) == predictions.prediction());
+
+  std::reverse(match_set.begin(), match_set.end());
+  predictions.select(pool, match_set);
+  CHECK(Vector({ 0 }) == predictions.prediction());
+}
+
+
+TEST(TestPredictionArray, test_rules_without_fitness_pay_nothing)
+{
+  define(Rule({Interval(0, 100)}, { 0 }), Performance(0.0, 1.0, 1.0));
+  define(Rule({Interval(0, 100)}, { 30 }), Performance(0.5, 1.0, 1.0));
+
+  predictions.select(pool, match_set);
+
+  CHECK(Vector({ 30 }) == predictions.prediction());
+}
+
+
+TEST(TestMetaRulePool, test_handle_goes_stale_after_release)
+{
+  MetaRule *rule = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  const RuleHandle handle = pool.handle(rule->slot());
+  CHECK(pool.is_current(handle));
+
+  pool.release(rule);
+  MetaRule *other_rule = pool.acquire(Rule({Interval(30, 40)}, { 45 }));
+
+  CHECK_EQUAL(rule->slot(), other_rule->slot());
+  CHECK_FALSE(pool.is_current(handle));
+  CHECK(pool.is_current(pool.handle(other_rule->slot())));
+}
+
+
+TEST(TestMetaRulePool, test_slabs)
+{
+  MetaRule *first_rule = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  for (unsigned int index=0 ; index<MetaRulePool::SLAB_SIZE ; ++index) {
+    pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  }
+
+  CHECK_EQUAL(2, pool.slab_count());
+  POINTERS_EQUAL(first_rule, &pool.rule(first_rule->slot()));
+}
+
+
+TEST(TestMetaRulePool, test_occupancy)
+{
+  DOUBLES_EQUAL(0, pool.occupancy(), 1e-9);
+
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  pool.release(rule_1);
+
+  CHECK_EQUAL(2, pool.slot_count());
+  DOUBLES_EQUAL(0.5, pool.occupancy(), 1e-9);
+}
+
+
+TEST(TestMetaRulePool, test_timestamps)
+{
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  pool.tick();
+  pool.tick();
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+
+  CHECK_EQUAL(2, pool.now());
+  CHECK_EQUAL(0, pool.timestamp(rule_1->slot()));
+  CHECK_EQUAL(2, pool.timestamp(rule_2->slot()));
+
+  pool.tick();
+  pool.stamp(rule_1->slot());
+  CHECK_EQUAL(3, pool.timestamp(rule_1->slot()));
+}
+
+
+TEST(TestMetaRulePool, test_experience)
+{
+  MetaRule *rule = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  pool.add_experience(rule->slot());
+  pool.add_experience(rule->slot());
+  CHECK_EQUAL(2, pool.experience(rule->slot()));
+
+  pool.release(rule);
+  rule = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  CHECK_EQUAL(0, pool.experience(rule->slot()));
+}
+
+
+TEST(TestMetaRulePool, test_subsumes)
+{
+  MetaRulePool pool(Dimensions(2, 1));
+  MetaRule *general = pool.acquire(Rule({Interval(10, 30), Interval(0, 50)}, { 35 }));
+  MetaRule *specific = pool.acquire(Rule({Interval(15, 30), Interval(20, 40)}, { 35 }));
+  MetaRule *across = pool.acquire(Rule({Interval(5, 20), Interval(20, 40)}, { 35 }));
+  MetaRule *other = pool.acquire(Rule({Interval(15, 30), Interval(20, 40)}, { 36 }));
+
+  CHECK(pool.subsumes(general->slot(), specific->slot()));
+  CHECK(pool.subsumes(general->slot(), general->slot()));
+  CHECK_FALSE(pool.subsumes(specific->slot(), general->slot()));
+  CHECK_FALSE(pool.subsumes(general->slot(), across->slot()));
+  CHECK_FALSE(pool.subsumes(general->slot(), other->slot()));
+  CHECK_EQUAL(70, pool.generality(general->slot()));
+  CHECK_EQUAL(35, pool.generality(specific->slot()));
+}
+
+
+TEST(TestMetaRulePool, test_content_chains)
+{
+  vector<MetaRule*> rules;
+  for (unsigned int index=0 ; index<2 * MetaRulePool::SLAB_SIZE ; ++index) {
+    rules.push_back(pool.acquire(Rule({Interval(index % 50, 50)}, { static_cast<int>(index % 7) })));
+  }
+  for (unsigned int index=0 ; index<rules.size() ; index += 3) {
+    pool.release(rules[index]);
+  }
+
+  for (unsigned int index=0 ; index<rules.size() ; ++index) {
+    const unsigned int slot = rules[index]->slot();
+    bool chained = false;
+    for (unsigned int each = pool.first_with_content(pool.content_hash(slot)) ;
+	 each != MetaRulePool::NO_SLOT ;
+	 each = pool.next_with_content(each)) {
+      chained = chained or (each == slot);
+      CHECK(pool.is_active(&pool.rule(each)));
+    }
+    CHECK_EQUAL(index % 3 != 0, chained);
+  }
+}
+
+
+TEST(TestMetaRulePool, test_same_content)
+{
+  MetaRule *rule_1 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  MetaRule *rule_2 = pool.acquire(Rule({Interval(10, 20)}, { 35 }));
+  MetaRule *rule_3 = pool.acquire(Rule({Interval(10, 21)}, { 35 }));
+
+  CHECK(pool.same_content(rule_1->slot(), rule_2->slot()));
+  CHECK_FALSE(pool.same_content(rule_1->slot(), rule_3->slot()));
+  CHECK_EQUAL(1, rule_1->numerosity());
+}
@@ -28,6 +28,7 @@
 TEST_GROUP(TestRouletteWheel)
 {
   Randomizer *randomizer;
+  MetaRulePool pool;
   MetaRule *rule_1, *rule_2, *rule_3;
   RuleSet *rules;
 
@@ -36,24 +37,21 @@ TEST_GROUP(TestRouletteWheel)
 
     rules = new RuleSet();
     
-    rule_1 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_1 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(1.0, 1.0, 1.0));
     rules->add(*rule_1);
     
-    rule_2 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_2 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(2.0, 3.0, 1.0));
     rules->add(*rule_2);
     
-    rule_3 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_3 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(3.0, 1.0, 1.0));
     rules->add(*rule_3);
   }
 
   void teardown(void) {
     delete randomizer;
-    delete rule_1;
-    delete rule_2;
-    delete rule_3;
     delete rules;
   }
 
@@ -75,8 +73,8 @@ TEST(TestRouletteWheel, test_one_rule_rule_set)
   RouletteWheel selection(*randomizer);
 
   RuleSet one_rule;
-  MetaRule rule(Rule( { Interval(23, 45) }, { 29 }), Performance(0, 0, 0));
-  one_rule.add(rule);
+  MetaRule *rule = pool.acquire(Rule( { Interval(23, 45) }, { 29 }), Performance(0, 0, 0));
+  one_rule.add(*rule);
   
   CHECK_THROWS(std::invalid_argument, {selection(one_rule);});
 }
@@ -97,6 +95,7 @@ TEST(TestRouletteWheel, test_simple)
 TEST_GROUP(TestZeroFitness)
 {
   Randomizer *randomizer;
+  MetaRulePool pool;
   MetaRule *rule_1, *rule_2, *rule_3;
   RuleSet *rules;
 
@@ -105,24 +104,21 @@ TEST_GROUP(TestZeroFitness)
 
     rules = new RuleSet();
     
-    rule_1 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_1 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(0.0, 1.0, 1.0));
     rules->add(*rule_1);
     
-    rule_2 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_2 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(0.0, 1.0, 1.0));
     rules->add(*rule_2);
     
-    rule_3 = new MetaRule(Rule({ Interval(0, 25) }, { 12 }),
+    rule_3 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
 			  Performance(0.0, 1.0, 1.0));
     rules->add(*rule_3);
   }
 
   void teardown(void) {
     delete randomizer;
-    delete rule_1;
-    delete rule_2;
-    delete rule_3;
     delete rules;
   }
 
@@ -139,3 +135,259 @@ TEST(TestZeroFitness, test_simple)
   CHECK(selected_rules[0] == rule_1);
   CHECK(selected_rules[1] == rule_2);
 }
+
+
+TEST_GROUP(TestDeletion)
+{
+  MetaRulePool pool;
+  MetaRule *rule_1, *rule_2, *rule_3;
+  RuleSet *rules;
+
+  void setup(void) {
+    rules = new RuleSet();
+
+    rule_1 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			  Performance(1.0, 1.0, 1.0));
+    rules->add(*rule_1);
+
+    rule_2 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			  Performance(2.0, 3.0, 1.0));
+    rules->add(*rule_2);
+
+    rule_3 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			  Performance(3.0, 1.0, 1.0));
+    rules->add(*rule_3);
+  }
+
+  void teardown(void) {
+    delete rules;
+  }
+
+};
+
+
+TEST(TestDeletion, test_worst_deletion)
+{
+  WorstDeletion deletion;
+
+  vector<MetaRule*> deleted = deletion(*rules, 2);
+
+  CHECK_EQUAL(2, deleted.size());
+  CHECK_EQUAL(1, rules->size());
+  CHECK((*rules)[0] == *rule_2);
+}
+
+
+TEST(TestDeletion, test_worst_deletion_beyond_the_rule_set)
+{
+  WorstDeletion deletion;
+
+  vector<MetaRule*> deleted = deletion(*rules, 5);
+
+  CHECK_EQUAL(3, deleted.size());
+  CHECK(rules->is_empty());
+}
+
+
+TEST(TestDeletion, test_tournament_deletion)
+{
+  TestableRandomizer randomizer({ 0.5, 1.0 });
+  TournamentDeletion deletion(randomizer, 2);
+
+  vector<MetaRule*> deleted = deletion(*rules, 1);
+
+  CHECK_EQUAL(1, deleted.size());
+  CHECK(deleted[0] == rule_3);
+  CHECK_EQUAL(2, rules->size());
+  CHECK_FALSE(rules->remove(*rule_3));
+}
+
+
+TEST(TestDeletion, test_tournament_may_delete_any_rule)
+{
+  TestableRandomizer randomizer({ 0.0 });
+  TournamentDeletion deletion(randomizer, 1);
+
+  for (unsigned int position=0 ; position<rules->size() ; ++position) {
+    RuleSet candidates(*rules);
+    randomizer.sequence({ (position + 0.5) / rules->size() });
+
+    vector<MetaRule*> deleted = deletion(candidates, 1);
+
+    CHECK(deleted[0] == &(*rules)[position]);
+  }
+}
+
+
+TEST(TestDeletion, test_empty_tournament)
+{
+  TestableRandomizer randomizer({ 0.5 });
+
+  CHECK_THROWS(std::invalid_argument, { TournamentDeletion deletion(randomizer, 0); });
+}
+
+
+TEST(TestRouletteWheel, test_follows_performance_updates)
+{
+  TestableRandomizer draws({ 1.0 });
+  RouletteWheel selection(draws);
+  rule_1->update(10.0, 1.0, 1.0);
+
+  vector<MetaRule*> selected_rules = selection(*rules);
+
+  CHECK(selected_rules[0] == rule_3);
+  CHECK(selected_rules[1] == rule_2);
+
+  draws.sequence({ 0.1 });
+  selected_rules = selection(*rules);
+
+  CHECK(selected_rules[0] == rule_1);
+  CHECK(selected_rules[1] == rule_2);
+}
+
+
+TEST(TestRouletteWheel, test_skips_released_rules)
+{
+  RouletteWheel selection(*randomizer);
+  MetaRule *released = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+				    Performance(5.0, 5.0, 1.0));
+  pool.release(released);
+
+  vector<MetaRule*> selected_rules = selection(*rules);
+
+  CHECK(selected_rules[0] == rule_3);
+  CHECK(selected_rules[1] == rule_2);
+}
+
+
+TEST(TestRouletteWheel, test_subset_of_the_pool)
+{
+  RouletteWheel selection(*randomizer);
+  RuleSet subset;
+  subset.add(*rule_1);
+  subset.add(*rule_2);
+
+  vector<MetaRule*> selected_rules = selection(subset);
+
+  CHECK(selected_rules[0] == rule_2);
+  CHECK(selected_rules[1] == rule_1);
+}
+
+
+TEST(TestRouletteWheel, test_same_choice_as_a_linear_scan)
+{
+  TestableRandomizer draws({ 1.0 });
+  RouletteWheel selection(draws);
+  MetaRule *outsider = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+				    Performance(1.0, 1.0, 1.0));
+
+  for (double each_draw: { 0.05, 0.3, 0.5, 0.8, 0.95 }) {
+    draws.sequence({ each_draw });
+    vector<MetaRule*> linear = selection(*rules);
+    pool.release(outsider);
+    vector<MetaRule*> indexed = selection(*rules);
+    outsider = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			    Performance(1.0, 1.0, 1.0));
+
+    CHECK(linear == indexed);
+  }
+}
+
+
+TEST_GROUP(TestTournamentSelection)
+{
+  MetaRulePool pool;
+  MetaRule *rule_1, *rule_2, *rule_3;
+  RuleSet *rules;
+
+  void setup(void) {
+    rules = new RuleSet();
+
+    rule_1 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			  Performance(1.0, 1.0, 1.0));
+    rules->add(*rule_1);
+
+    rule_2 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			  Performance(2.0, 3.0, 1.0));
+    rules->add(*rule_2);
+
+    rule_3 = pool.acquire(Rule({ Interval(0, 25) }, { 12 }),
+			  Performance(3.0, 1.0, 1.0));
+    rules->add(*rule_3);
+  }
+
+  void teardown(void) {
+    delete rules;
+  }
+
+};
+
+
+TEST(TestTournamentSelection, test_best_of_the_tournament)
+{
+  TestableRandomizer randomizer({ 0.0, 1.0 });
+  TournamentSelection selection(randomizer, 2);
+
+  vector<MetaRule*> selected_rules = selection(*rules);
+
+  CHECK_EQUAL(2, selected_rules.size());
+  CHECK(selected_rules[0] == rule_3);
+  CHECK(selected_rules[1] == rule_1);
+}
+
+
+TEST(TestTournamentSelection, test_parents_differ)
+{
+  TestableRandomizer randomizer({ 0.5 });
+  TournamentSelection selection(randomizer, 3);
+
+  vector<MetaRule*> selected_rules = selection(*rules);
+
+  CHECK(selected_rules[0] == rule_2);
+  CHECK(selected_rules[1] == rule_3);
+}
+
+
+TEST(TestTournamentSelection, test_may_select_any_rule)
+{
+  TestableRandomizer randomizer({ 0.0 });
+  TournamentSelection selection(randomizer, 1);
+
+  for (unsigned int position=0 ; position<rules->size() ; ++position) {
+    randomizer.sequence({ (position + 0.5) / rules->size() });
+
+    vector<MetaRule*> selected_rules = selection(*rules);
+
+    CHECK(selected_rules[0] == &(*rules)[position]);
+  }
+}
+
+
+TEST(TestTournamentSelection, test_two_rules_rule_set)
+{
+  Randomizer randomizer(42);
+  TournamentSelection selection(randomizer, 1);
+  RuleSet two_rules;
+  two_rules.add(*rule_1).add(*rule_2);
+
+  bool first_is_last = false;
+  for (unsigned int draw=0 ; draw<100 ; ++draw) {
+    vector<MetaRule*> selected_rules = selection(two_rules);
+    CHECK(selected_rules[0] != selected_rules[1]);
+    first_is_last = first_is_last or selected_rules[0] == rule_2;
+  }
+
+  CHECK(first_is_last);
+}
+
+
+TEST(TestTournamentSelection, test_one_rule_rule_set)
+{
+  TestableRandomizer randomizer({ 0.5 });
+  TournamentSelection selection(randomizer);
+
+  RuleSet one_rule;
+  one_rule.add(*rule_1);
+
+  CHECK_THROWS(std::invalid_argument, {selection(one_rule);});
+}
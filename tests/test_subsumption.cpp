@@ -0,0 +1,147 @@
+/*
+ * This file is part of XCSF.
+ *
+ * XCSF is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * XCSF is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with XCSF.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include "CppUTest/TestHarness.h"
+
+
+#include "subsumption.h"
+#include "matching.h"
+
+#include "helpers.h"
+
+
+using namespace xcsf;
+
+
+
+TEST_GROUP(TestSubsumption)
+{
+  const double		 error_threshold = 10;
+  const unsigned int	 experience_threshold = 2;
+  MetaRulePool		 pool;
+  RuleSet		 rules;
+  Subsumption		*subsumption;
+
+  void setup(void)
+  {
+    subsumption = new Subsumption(error_threshold, experience_threshold);
+  }
+
+  void teardown(void)
+  {
+    delete subsumption;
+  }
+
+  MetaRule* experienced(const Rule& rule, double error)
+  {
+    MetaRule* result = pool.acquire(rule, Performance(1.0, 1.0, error));
+    for (unsigned int step=0 ; step<=experience_threshold ; ++step) {
+      pool.add_experience(result->slot());
+    }
+    return result;
+  }
+
+};
+
+
+TEST(TestSubsumption, test_subsumers_are_accurate_and_experienced)
+{
+  MetaRule* novice = pool.acquire(Rule({Interval(0, 50)}, { 4 }), Performance(1.0, 1.0, 0.0));
+  MetaRule* inaccurate = experienced(Rule({Interval(0, 50)}, { 4 }), 20.0);
+  MetaRule* subsumer = experienced(Rule({Interval(0, 50)}, { 4 }), 1.0);
+
+  CHECK_FALSE(subsumption->can_subsume(pool, novice->slot()));
+  CHECK_FALSE(subsumption->can_subsume(pool, inaccurate->slot()));
+  CHECK(subsumption->can_subsume(pool, subsumer->slot()));
+}
+
+
+TEST(TestSubsumption, test_subsumer_of_a_child)
+{
+  MetaRule* other_conclusion = experienced(Rule({Interval(0, 100)}, { 6 }), 1.0);
+  MetaRule* general = experienced(Rule({Interval(0, 50)}, { 4 }), 1.0);
+  rules.add(*other_conclusion).add(*general);
+
+  MetaRule* child = pool.acquire(Rule({Interval(10, 20)}, { 4 }));
+
+  CHECK_EQUAL(general, subsumption->subsumer(rules, *child));
+}
+
+
+TEST(TestSubsumption, test_no_subsumer_outside_the_rule_set)
+{
+  MetaRule* outsider = experienced(Rule({Interval(0, 50)}, { 4 }), 1.0);
+  MetaRule* specific = experienced(Rule({Interval(5, 50)}, { 4 }), 1.0);
+  rules.add(*specific);
+
+  MetaRule* child = pool.acquire(Rule({Interval(0, 20)}, { 4 }));
+
+  CHECK(outsider != nullptr);
+  CHECK(subsumption->subsumer(rules, *child) == nullptr);
+}
+
+
+TEST(TestSubsumption, test_indexed_subsumer_lookup)
+{
+  ValueIndex index(pool.dimensions().input_count());
+  pool.index_with(&index);
+
+  MetaRule* general = experienced(Rule({Interval(0, 50)}, { 4 }), 1.0);
+  rules.add(*general);
+  MetaRule* inside = pool.acquire(Rule({Interval(10, 20)}, { 4 }));
+  MetaRule* across = pool.acquire(Rule({Interval(40, 60)}, { 4 }));
+
+  CHECK_EQUAL(general, subsumption->subsumer(rules, *inside));
+  CHECK(subsumption->subsumer(rules, *across) == nullptr);
+
+  pool.index_with(nullptr);
+}
+
+
+TEST(TestSubsumption, test_action_set_subsumption)
+{
+  MetaRule* general = experienced(Rule({Interval(0, 50)}, { 4 }), 1.0);
+  MetaRule* specific = experienced(Rule({Interval(10, 40)}, { 4 }), 1.0);
+  MetaRule* other_conclusion = experienced(Rule({Interval(20, 30)}, { 6 }), 1.0);
+  pool.set_numerosity(specific->slot(), 3);
+  rules.add(*specific).add(*general).add(*other_conclusion);
+
+  vector<unsigned int> action_set = { specific->slot(), general->slot(), other_conclusion->slot() };
+  (*subsumption)(rules, SlotSpan(action_set));
+
+  CHECK_EQUAL(2, rules.size());
+  CHECK_EQUAL(4, general->numerosity());
+  CHECK(rules.contains(*other_conclusion));
+  CHECK_EQUAL(2, pool.active_rule_count());
+}
+
+
+TEST(TestSubsumption, test_no_action_set_subsumption_without_subsumer)
+{
+  MetaRule* general = experienced(Rule({Interval(0, 50)}, { 4 }), 20.0);
+  MetaRule* specific = experienced(Rule({Interval(10, 40)}, { 4 }), 1.0);
+  rules.add(*specific).add(*general);
+
+  vector<unsigned int> action_set = { specific->slot(), general->slot() };
+  (*subsumption)(rules, SlotSpan(action_set));
+
+  CHECK_EQUAL(2, rules.size());
+  CHECK_EQUAL(1, general->numerosity());
+}
@@ -21,6 +21,8 @@
 
 #include "helpers.h"
 
+#include <cmath>
+
 
 
 using namespace xcsf;
@@ -106,13 +108,35 @@ TEST(TestRandomizer, test_unsigned_int)
   CHECK_EQUAL(0, value);
 
   value = generate->unsigned_int(0, 100);
-  CHECK_EQUAL(49, value);
+  CHECK_EQUAL(50, value);
 
   value = generate->unsigned_int(0, 100);
   CHECK_EQUAL(99, value);
 }
 
 
+TEST(TestRandomizer, test_index)
+{
+  CHECK_EQUAL(0, generate->index(3));
+  CHECK_EQUAL(1, generate->index(3));
+  CHECK_EQUAL(2, generate->index(3));
+}
+
+
+TEST(TestRandomizer, test_index_reaches_every_position)
+{
+  Randomizer generate(42);
+  vector<bool> drawn(4, false);
+  for (unsigned int draw=0 ; draw<1000 ; ++draw) {
+    const unsigned int position = generate.index(drawn.size());
+    CHECK(position < drawn.size());
+    drawn[position] = true;
+  }
+
+  CHECK(drawn == vector<bool>(4, true));
+}
+
+
 TEST(TestRandomizer, test_real_output)
 {
   double total(0);
@@ -124,3 +148,182 @@ TEST(TestRandomizer, test_real_output)
   CHECK(total > 0);
   
 }
+
+
+TEST(TestRandomizer, test_seeded_generators_are_reproducible)
+{
+  Randomizer generate(42), same_generate(42), other_generate(43);
+
+  bool differ = false;
+  for (unsigned int index=0 ; index<100 ; ++index) {
+    const double value = generate.uniform();
+    CHECK(value >= 0. and value < 1.);
+    CHECK(value == same_generate.uniform());
+    differ = differ or (value != other_generate.uniform());
+  }
+  CHECK(differ);
+}
+
+
+TEST(TestRandomizer, test_split_streams_differ)
+{
+  Randomizer generate(42), same_generate(42);
+  Randomizer stream = generate.split();
+
+  CHECK(stream.uniform() == same_generate.uniform());
+  CHECK(generate.uniform() != stream.uniform());
+}
+
+
+TEST(TestRandomizer, test_jump)
+{
+  Randomizer generate(42), jumped(42);
+  jumped.jump();
+
+  const Randomizer stream = Randomizer(42).split();
+  const double value = jumped.uniform();
+  CHECK(value != generate.uniform());
+  CHECK(value != stream.uniform());
+}
+
+
+TEST(TestRandomizer, test_bulk_draws)
+{
+  Randomizer generate(7), same_generate(7);
+
+  vector<double> values(100);
+  generate.uniforms(values.data(), values.size());
+  for (auto each_value: values) {
+    CHECK(each_value == same_generate.uniform());
+  }
+
+  vector<unsigned int> integers(150);
+  generate.unsigned_ints(integers.data(), integers.size(), 10, 20);
+  for (auto each_integer: integers) {
+    CHECK_EQUAL(same_generate.unsigned_int(10, 20), each_integer);
+  }
+}
+
+
+TEST(TestRandomizer, test_canned_bulk_draws)
+{
+  vector<unsigned int> integers(3);
+  generate->unsigned_ints(integers.data(), integers.size(), 0, 100);
+
+  CHECK(vector<unsigned int>({ 0, 50, 99 }) == integers);
+}
+
+
+TEST(TestRandomizer, test_largest_draw_reaches_the_upper_bound)
+{
+  TestableRandomizer largest({ std::nextafter(1., 0.) });
+
+  CHECK_EQUAL(19, largest.unsigned_int(10, 20));
+
+  vector<unsigned int> integers(3);
+  largest.unsigned_ints(integers.data(), integers.size(), 10, 20);
+  CHECK(vector<unsigned int>({ 19, 19, 19 }) == integers);
+}
+
+
+TEST_GROUP(TestBitmask)
+{};
+
+
+TEST(TestBitmask, test_initially_clear)
+{
+  Bitmask mask(70);
+
+  CHECK_EQUAL(70, mask.size());
+  CHECK_EQUAL(2, mask.word_count());
+  for (unsigned int index=0 ; index<70 ; ++index) {
+    CHECK_FALSE(mask[index]);
+  }
+}
+
+
+TEST(TestBitmask, test_set)
+{
+  Bitmask mask(70);
+  mask.set(3);
+  mask.set(65);
+
+  CHECK(mask[3]);
+  CHECK(mask[65]);
+  CHECK_FALSE(mask[64]);
+}
+
+
+TEST(TestBitmask, test_reset)
+{
+  Bitmask mask(10);
+  mask.set(3);
+  mask.reset(130);
+
+  CHECK_EQUAL(130, mask.size());
+  CHECK_FALSE(mask[3]);
+}
+
+
+TEST_GROUP(TestFenwickTree)
+{
+  FenwickTree weights;
+
+  void setup(void) {
+    weights.grow(5);
+    weights.set(0, 1.);
+    weights.set(1, 0.);
+    weights.set(2, 3.);
+    weights.set(3, 2.);
+    weights.set(4, 4.);
+  }
+};
+
+
+TEST(TestFenwickTree, test_prefix)
+{
+  DOUBLES_EQUAL(0., weights.prefix(0), 1e-9);
+  DOUBLES_EQUAL(1., weights.prefix(2), 1e-9);
+  DOUBLES_EQUAL(6., weights.prefix(4), 1e-9);
+  DOUBLES_EQUAL(10., weights.total(), 1e-9);
+}
+
+
+TEST(TestFenwickTree, test_find)
+{
+  CHECK_EQUAL(0, weights.find(0.5));
+  CHECK_EQUAL(0, weights.find(1.));
+  CHECK_EQUAL(2, weights.find(1.5));
+  CHECK_EQUAL(3, weights.find(5.));
+  CHECK_EQUAL(4, weights.find(10.));
+}
+
+
+TEST(TestFenwickTree, test_update)
+{
+  weights.set(2, 0.5);
+
+  DOUBLES_EQUAL(0.5, weights.weight(2), 1e-9);
+  DOUBLES_EQUAL(7.5, weights.total(), 1e-9);
+  CHECK_EQUAL(3, weights.find(2.));
+}
+
+
+TEST(TestFenwickTree, test_negative_weights_count_as_zero)
+{
+  weights.set(4, -3.);
+
+  DOUBLES_EQUAL(0., weights.weight(4), 1e-9);
+  DOUBLES_EQUAL(6., weights.total(), 1e-9);
+}
+
+
+TEST(TestFenwickTree, test_grow)
+{
+  weights.grow(9);
+  weights.set(8, 2.);
+
+  CHECK_EQUAL(9, weights.size());
+  DOUBLES_EQUAL(12., weights.total(), 1e-9);
+  CHECK_EQUAL(8, weights.find(11.));
+}
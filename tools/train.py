@@ -19,6 +19,7 @@ class Data:
 
 class Agent:
     EXECUTABLE = "bin/dist/XCSF_0.0.1.exe"
+    WINDOW = 64  # action sets the agent keeps for later rewards
 
     def __init__(self, logfile):
         self._logfile = logfile
@@ -27,15 +28,36 @@ class Agent:
                               stdout=PIPE,
                               bufsize=1,
                               universal_newlines=True)
+        self._next_ticket = 0
         self._receive()
 
-    def accept_reward(self, reward):
-        text = "R:%.4f\n" % reward
+    def accept_reward(self, reward, ticket=None):
+        if ticket is None:
+            text = "R:%.4f\n" % reward
+        else:
+            text = "R:%d:%.4f\n" % (ticket, reward)
         self._send(text)
 
     def predict(self, observation):
-        self._send("P:(%.2f)\n" % observation)
-        return float(self._receive().strip("[]\n"))
+        return self.predict_all([observation])[0][1]
+
+    def predict_all(self, observations):
+        """Sends all the observations in a single batch, and returns the
+        predictions along with their tickets"""
+        self._send("BP:%s\n" % ";".join("(%.2f)" % each
+                                         for each in observations))
+        self._process.stdin.flush()
+        predictions = self._receive().strip("\n").split(";")
+        results = []
+        for each_prediction in predictions:
+            results.append((self._next_ticket,
+                            float(each_prediction.strip("[]"))))
+            self._next_ticket += 1
+        return results
+
+    def accept_rewards(self, first_ticket, rewards):
+        self._send("BR:%d:%s\n" % (first_ticket,
+                                   ";".join("%.4f" % each for each in rewards)))
 
     def _send(self, text):
         logfile.write(">>>" + text)
@@ -57,11 +79,16 @@ class Coach:
     def train(self, trainee, rounds=10):
         progress = []
         for round in range(rounds):
-            for each_data in self._training_data:
-                prediction = trainee.predict(each_data.observation)
-                money = self._reward(each_data, prediction)
-                trainee.accept_reward(money)
-                progress.append((each_data.error_with(prediction), money))
+            for start in range(0, len(self._training_data), trainee.WINDOW):
+                chunk = self._training_data[start:start + trainee.WINDOW]
+                predictions = trainee.predict_all(
+                    [each.observation for each in chunk])
+                rewards = []
+                for each_data, (_, prediction) in zip(chunk, predictions):
+                    money = self._reward(each_data, prediction)
+                    rewards.append(money)
+                    progress.append((each_data.error_with(prediction), money))
+                trainee.accept_rewards(predictions[0][0], rewards)
         return progress
 
     def _reward(self, data, prediction):